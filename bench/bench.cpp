@@ -0,0 +1,262 @@
+/*
+   This software is licensed under the MIT License. See the license file for details.
+   Source: https://github.com/spacehuhntech/WiFiDuck
+ */
+
+// Host benchmark for the script engine, built by [env:native]:
+//   pio run -e native -t exec
+// Every payload in bench/payloads (or every file given as argument) is
+//  - compiled BENCH_RUNS times to measure lines/sec parsed
+//  - run through duckscript to count the HID reports written to Serial,
+//    once with strict press/release pairs and once with OPTIMIZE ON
+// Heap allocations are counted by wrapping malloc (see build_flags)
+// and are reported per line of the payload.
+
+#include <Arduino.h>
+
+#include "config.h"
+#include "duckparser.h"
+#include "duckscript.h"
+#include "keyboard.h"
+#include "spiffs.h"
+
+#include <dirent.h>    // opendir
+#include <stdio.h>     // printf
+#include <stdlib.h>    // malloc
+#include <chrono>      // steady_clock
+#include <new>         // operator new
+#include <string>      // std::string
+#include <vector>      // std::vector
+#include <algorithm>   // std::sort
+
+#define BENCH_RUNS 200
+#define BENCH_DIR "bench/payloads"
+#define REPORT_SIZE 8
+
+// ===== Allocation counter ===== //
+static size_t allocations = 0;
+
+extern "C" {
+    void* __real_malloc(size_t size);
+    void* __wrap_malloc(size_t size) {
+        ++allocations;
+        return __real_malloc(size);
+    }
+}
+
+// libstdc++ calls its own malloc, so new has to be counted separately
+void* operator new(size_t size) {
+    ++allocations;
+    void* ptr = __real_malloc(size ? size : 1);
+    if (!ptr) throw std::bad_alloc();
+    return ptr;
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept {
+    free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    free(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept {
+    free(ptr);
+}
+
+// ===== Payloads ===== //
+typedef struct payload_t {
+    std::string name;
+    std::string text;
+    size_t      lines;
+    size_t      string_bytes;
+} payload_t;
+
+static bool load(const std::string& path, payload_t& p) {
+    FILE* f = fopen(path.c_str(), "rb");
+
+    if (!f) return false;
+
+    p.name = path.substr(path.find_last_of('/') + 1);
+    p.text.clear();
+
+    char   buf[256];
+    size_t n;
+
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) p.text.append(buf, n);
+    fclose(f);
+
+    // Count lines and the characters behind STRING, that's what gets typed
+    p.lines        = 0;
+    p.string_bytes = 0;
+
+    size_t i = 0;
+
+    while (i < p.text.size()) {
+        size_t end = p.text.find('\n', i);
+        if (end == std::string::npos) end = p.text.size();
+
+        size_t len = end - i;
+        if ((len > 0) && (p.text[end - 1] == '\r')) --len;
+
+        if ((len > 7) && (p.text.compare(i, 7, "STRING ") == 0)) p.string_bytes += len - 7;
+
+        ++p.lines;
+        i = end + 1;
+    }
+
+    return true;
+}
+
+static std::vector<std::string> list(int argc, char** argv) {
+    std::vector<std::string> paths;
+
+    for (int i = 1; i < argc; ++i) paths.push_back(argv[i]);
+
+    if (paths.empty()) {
+        DIR* d = opendir(BENCH_DIR);
+
+        if (d) {
+            while (dirent* e = readdir(d)) {
+                if (e->d_name[0] != '.') paths.push_back(std::string(BENCH_DIR "/") + e->d_name);
+            }
+            closedir(d);
+        }
+        std::sort(paths.begin(), paths.end());
+    }
+
+    return paths;
+}
+
+// ===== Measurements ===== //
+static void emit_nothing(uint8_t code, const uint8_t* data, size_t len) {}
+
+static double compile_rate(const payload_t& p) {
+    auto start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < BENCH_RUNS; ++i) {
+        duckparser::compile(p.text.c_str(), p.text.size(), emit_nothing);
+    }
+
+    std::chrono::duration<double> t = std::chrono::steady_clock::now() - start;
+
+    return (double)(p.lines * BENCH_RUNS) / t.count();
+}
+
+// Runs a script until all of its reports are sent, without waiting for any DELAY
+static void runScript(String fileName) {
+    duckscript::run(fileName);
+
+    while (duckscript::isRunning() || (keyboard::queued() > 0)) {
+        unsigned int idle = duckscript::idleTime();
+
+        native::advanceTime(idle > 0 ? idle : 1);
+        keyboard::update();
+        duckscript::nextLine();
+    }
+}
+
+static void run(const payload_t& p, bool optimize, size_t& reports, size_t& allocs, double& rate) {
+    String fileName = "/bench.txt";
+    String text     = optimize ? "OPTIMIZE ON\n" : "OPTIMIZE OFF\n";
+
+    text += p.text.c_str();
+
+    spiffs::remove(fileName);
+    spiffs::remove("/bench.duckc");
+    spiffs::remove("/bench.duckl");
+    spiffs::write(fileName, (const uint8_t*)text.c_str(), text.length());
+
+    // First run compiles the script, only the second is measured
+    runScript(fileName);
+
+    Serial.clear();
+    Serial.tx_bytes = 0;
+    allocations     = 0;
+
+    auto start = std::chrono::steady_clock::now();
+
+    runScript(fileName);
+
+    std::chrono::duration<double> t = std::chrono::steady_clock::now() - start;
+
+    reports = Serial.tx_bytes / REPORT_SIZE;
+    allocs  = allocations;
+    rate    = (double)p.lines / t.count();
+
+    keyboard::setLocale(&locale_us);
+}
+
+// Tests have a main() of their own, see test/
+#ifndef PIO_UNIT_TESTING
+int main(int argc, char** argv) {
+    spiffs::begin();
+    keyboard::begin();
+
+    std::vector<std::string> paths = list(argc, argv);
+
+    if (paths.empty()) {
+        printf("No payloads found in " BENCH_DIR "\n");
+        return 1;
+    }
+
+    size_t strict_total    = 0;
+    size_t optimized_total = 0;
+    size_t string_total    = 0;
+
+    printf("%-16s %6s %10s %10s %8s %8s %8s %8s %9s\n",
+           "payload", "lines", "parse/s", "run/s", "reports", "opt", "rep/b", "opt/b", "allocs/ln");
+
+    for (const std::string& path : paths) {
+        payload_t p;
+
+        if (!load(path, p)) {
+            printf("%-16s could not be read\n", path.c_str());
+            continue;
+        }
+
+        size_t reports;
+        size_t opt_reports;
+        size_t allocs;
+        double run_rate;
+
+        double parse_rate = compile_rate(p);
+        run(p, true, opt_reports, allocs, run_rate);
+        run(p, false, reports, allocs, run_rate);
+
+        strict_total    += reports;
+        optimized_total += opt_reports;
+        string_total    += p.string_bytes;
+
+        printf("%-16s %6u %10.0f %10.0f %8u %8u %8.2f %8.2f %9.2f\n",
+               p.name.c_str(),
+               (unsigned int)p.lines,
+               parse_rate,
+               run_rate,
+               (unsigned int)reports,
+               (unsigned int)opt_reports,
+               p.string_bytes ? (double)reports / p.string_bytes : 0.0,
+               p.string_bytes ? (double)opt_reports / p.string_bytes : 0.0,
+               (double)allocs / p.lines);
+    }
+
+    // Typing speed when the UART is the limit, every report takes KEYBOARD_REPORT_TIME
+    if (strict_total > 0) {
+        printf("\nSTRING throughput at %uus per report: %.0f chars/s strict, %.0f chars/s optimized\n",
+               (unsigned int)KEYBOARD_REPORT_TIME,
+               string_total * 1000000.0 / ((double)strict_total * KEYBOARD_REPORT_TIME),
+               string_total * 1000000.0 / ((double)optimized_total * KEYBOARD_REPORT_TIME));
+    }
+
+    return 0;
+}
+
+#endif // ifndef PIO_UNIT_TESTING
@@ -0,0 +1,22 @@
+/*
+   This software is licensed under the MIT License. See the license file for details.
+   Source: https://github.com/spacehuhntech/WiFiDuck
+ */
+
+#pragma once
+
+#include <Arduino.h> // Print
+
+// Measures the device and writes the results as one JSON object:
+// {"version", "chip_id", "cpu_mhz", "heap",
+//  "parser": {"lines_per_s", "us_per_line"},
+//  "keyboard": {"null_reports_per_s", "uart_reports_per_s"},
+//  "fs": {"name", "open_us", "pooled_open_us", "read_kb_per_s", "write_kb_per_s", "ls_us", "ls_cached_us", "files"},
+//  "ws": {"rtt_us"}}
+// or {"error"} while a script or trace is running.
+// rtt_us is null without a web socket client or when the ping wasn't answered.
+// It takes a while, so request() only records it and update() runs it in loop().
+namespace benchmark {
+    void request();
+    void update();
+}
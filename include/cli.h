@@ -7,13 +7,7 @@
 
 #pragma once
 
-#include <Arduino.h> // String, bool
-
-/*! \typedef PrintFunction
- *  \brief A function that outputs a given string, for example to std::out.
- *  \param s String to be printed
- */
-typedef void (* PrintFunction)(const char* s);
+#include <Arduino.h> // Print, bool
 
 /*! \namespace CLI
  *  \brief Command line interface module
@@ -27,12 +21,16 @@ namespace cli {
      *
      * Analyzes the input string if it matches a command name and its arguments.
      * Resulting output, from a command or an error message,
-     * will be passed to printfunc.
-     * If echo is true, "# <input>" will be passed to printfunc first.
+     * will be written to out. Every message is followed by out.flush().
+     * If echo is true, "# <input>" will be written to out first.
+     *
+     * "batch <commands>" runs commands that are separated by
+     * line breaks or ";;" and flushes their output only once:
+     * "# <command>" followed by the output of every command.
      *
-     * \param input     String to be parsed
-     * \param printfunc Function that prints the result
-     * \param echo      Flag to enable echo of input
+     * \param input String to be parsed
+     * \param out   Where the result is written to
+     * \param echo  Flag to enable echo of input
      */
-    void parse(const char* input, PrintFunction printfunc, bool echo = true);
+    void parse(const char* input, Print& out, bool echo = true);
 }
\ No newline at end of file
@@ -39,6 +39,31 @@
 #define HOSTNAME "wifiduck"
 #define URL "wifi.duck"
 
+/*! ===== Keyboard Settings ===== */
+#define KEYBOARD_CACHE_SIZE 8192   // Memory for the reports of typed strings (bytes)
+#define KEYBOARD_CACHE_ENTRIES 8   // Strings that are cached at most
+#define KEYBOARD_CACHE_MIN_LEN 16  // Shorter strings are typed without the cache
+#define KEYBOARD_OPTIMIZE false    // Leave out releases between different keys, scripts opt in with OPTIMIZE ON
+#define KEYBOARD_QUEUE_SIZE 64     // Reports waiting to be sent to the CH9328
+#define KEYBOARD_REPORT_TIME 2100  // Time for sending one report (us), 8 bytes at 38400 baud take 2083us
+#define KEYBOARD_LAYOUT_CACHE 4    // Layouts loaded from SPIFFS that are kept in RAM
+#define TRACE_SIZE 128             // Sent reports the tracer keeps in RAM before writing them to SPIFFS
+
+/*! ===== Storage Settings ===== */
+#define STORAGE_LITTLEFS true          // false keeps the files on SPIFFS
+#define STORAGE_MIGRATE_RESERVE 16384  // Heap that stays free while the files of SPIFFS are moved to LittleFS (bytes)
+#define STORAGE_LITTLEFS_SPARE 4       // Blocks of LittleFS that aren't for files, like its superblocks and directory
+#define STORAGE_BENCH_SIZE 32768       // Size of the test file of the fsbench command (bytes)
+#define STORAGE_POOL_SIZE 4            // Files that are read often and kept open, like the running script
+#define UPLOAD_CHUNK_SIZE 1024         // Most data in one chunk of an upload over the web socket (bytes)
+#define UPLOAD_WINDOW 4096             // Data of an upload that may be sent before it was acknowledged (bytes)
+#define LZSS_MAX_WINDOW_BITS 10        // Largest window of a compressed script, it takes 2^bits bytes of RAM while it's read
+#define WS_FRAME_SIZE 512              // Output of the CLI that is sent in one web socket frame (bytes)
+#define WS_FRAME_POOL 2                // Frames that are kept for the output, more are made while they're all being sent
+#define PROTOCOL_FRAME_SIZE 512        // Largest response of the binary protocol in one frame, at most WS_FRAME_SIZE (bytes)
+
 /*! ===== Parser Settings ===== */
 #define CASE_SENSETIVE false
 #define DEFAULT_SLEEP 5
+#define IDLE_MAX_TIME 10 // Longest time loop() sleeps during a DELAY (ms)
+#define DUCKPARSER_ARENA_SIZE 512 // Memory for the nodes of one parsed line
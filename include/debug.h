@@ -19,9 +19,8 @@
 #define debug_update()\
     if (Serial.available()) {\
         String input = Serial.readStringUntil('\n');\
-        cli::parse(input.c_str(), [] (const char* str) {\
-            Serial.println(str);\
-        });\
+        cli::parse(input.c_str(), DEBUG_PORT);\
+        DEBUG_PORT.println();\
     }
 
 #else /* ifdef ENABLE_DEBUG */
@@ -0,0 +1,34 @@
+/*
+   This software is licensed under the MIT License. See the license file for details.
+   Source: https://github.com/spacehuhntech/WiFiDuck
+ */
+
+#pragma once
+
+#include <Arduino.h> // String
+
+#define DUCKC_EXTENSION ".duckc"
+#define DUCKL_EXTENSION ".duckl" // Line index, header + uint32 code offset of every line
+#define DUCKC_MAGIC "DUCK"
+#define DUCKC_VERSION 1
+#define DUCKC_NO_LINE UINT32_MAX // Offset of a line that isn't in the index
+
+namespace duckcompiler {
+    typedef struct header_t {
+        char     magic[4];
+        uint8_t  version;
+        uint8_t  reserved[3];
+        uint32_t src_size; // Size of the source script
+        uint32_t src_time; // Last write time of the source script
+    } header_t;
+
+    String codeName(String fileName);
+    String indexName(String fileName);
+    bool isCode(String fileName);
+
+    String compile(String fileName);
+    void invalidate(String fileName);
+
+    uint32_t lineOffset(String fileName, uint32_t line);
+    uint32_t lineAt(String fileName, uint32_t offset);
+}
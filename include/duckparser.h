@@ -7,10 +7,50 @@
 #pragma once
 
 #include <stddef.h> // size_t
+#include <stdint.h> // uint8_t
+
+#include "c/arena_types.h" // arena
+
+/*! ===== Instructions ===== */
+// Every instruction is [opcode][payload length][payload], numbers are little endian
+#define OP_HEADER_SIZE 2
+#define OP_MAX_LEN 255
+
+#define OP_STRING 0x01       // Text to type
+#define OP_DELAY 0x02        // uint32 milliseconds
+#define OP_DEFAULTDELAY 0x03 // uint32 milliseconds
+#define OP_REPEAT 0x04       // uint32 count (+ uint32 start, uint32 end of the repeated code in files)
+#define OP_LOCALE 0x05       // Name of the layout
+#define OP_LED 0x06          // Red, green, blue
+#define OP_KEYCODE 0x07      // Modifiers + 6 keys
+#define OP_PRESS 0x08        // Press items, then release all keys
+#define OP_HOLD 0x09         // Press items and keep them pressed
+#define OP_OPTIMIZE 0x0A     // 1 to leave out releases between different keys, 0 to release after every key
+
+#define OP_FLAG_DELAY 0x80   // Sleep for the default delay after the instruction
+
+// Items of OP_PRESS and OP_HOLD
+#define PRESS_KEY 0x01       // Key code
+#define PRESS_MOD 0x02       // Modifier bits
+#define PRESS_CHAR 0x03      // Length + character, looked up in the current locale
+
+/*! \typedef EmitFunction
+ *  \brief A function that receives one compiled instruction
+ *  \param code Opcode, including OP_FLAG_DELAY
+ *  \param data Payload, may point directly into the parsed text
+ *  \param len  Length of the payload
+ */
+typedef void (* EmitFunction)(uint8_t code, const uint8_t* data, size_t len);
 
 namespace duckparser {
     void parse(const char* str, size_t len);
+    void compile(const char* str, size_t len, EmitFunction emit);
+    size_t feed(const char* str, size_t len, bool eof, EmitFunction emit);
+    void execute(uint8_t code, const uint8_t* data, size_t len);
+    void reset();
+    const arena* getArena();
     int getRepeats();
     unsigned int getDelayTime();
+    bool isSleeping();
     bool isProcessing();
 };
\ No newline at end of file
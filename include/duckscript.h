@@ -9,13 +9,14 @@
 
 namespace duckscript {
     void runTest();
-    void run(String fileName);
+    void run(String fileName, uint32_t line = 1);
 
     void nextLine();
-    void repeat();
     void stopAll();
     void stop(String fileName);
 
     bool isRunning();
+    unsigned int idleTime();
+    uint32_t currentLine();
     String currentScript();
 };
\ No newline at end of file
@@ -0,0 +1,203 @@
+/*
+   This software is licensed under the MIT License. See the license file for details.
+   Source: https://github.com/spacehuhntech/WiFiDuck
+ */
+
+// Generated by scripts/keynames.py, do not edit!
+
+#pragma once
+
+#include "usb_hid_keys.h"
+
+#define KEYNAMES_LEN 155
+#define KEYNAMES_BUCKETS 52
+
+typedef struct keyname_t {
+    uint16_t name;     // Offset in keynames_pool
+    uint8_t  name_len;
+    uint8_t  key;
+    uint8_t  modifiers;
+} keyname_t;
+
+// Seed of the second hash for every bucket of the first hash
+const uint16_t keynames_seeds[] PROGMEM = {
+       35,    10,    10,     4,   100,    15,     4,     2,     8,     4,     2,    31,
+       88,     9,    22,     3,    15,    30,    19,     3,     4,     1,     9,    31,
+        2,    50,   100,     0,    21,   185,    22,    98,     6,    11,   462,    86,
+        3,     4,     9,     3,     1,     1,    81,    34,     1,   151,    53,     8,
+        2,     0,    85,    79,
+};
+
+const char keynames_pool[] PROGMEM =
+    "UNDOF10MUHENKANDOTDELETEKPENTERMEDIA_EJECTCDBACKSPACEVOLUMEUPKATAKANAFRONTF23SPA"
+    "CEF21MOD_LCTRLALTCAPSLOCKTABMEDIA_EDITBREAKMEDIA_CALCMUTESHIFTUPF15F16F13MOD_RAL"
+    "TMENUVOLUMEDOWNSCROLLLOCKKPLEFTPARENHENKANF24DOWNRIGHTALTF14ESCAPEF20RIGHTMEDIA_"
+    "PREVIOUSSONGMOD_LSHIFTF7PAUSEF19RIGHTARROWKPRIGHTPARENMEDIA_REFRESHKP5MEDIA_PLAY"
+    "PAUSELEFTMETAF9CTRLKPEQUALROEQUALF4KP7HELPMEDIA_MUTEF2F8KP0CUTKPDOTINSERTHIRAGAN"
+    "APAGEUPMINUSKPSLASHKP1F17YENKPASTERISKENDF3F12GUIMOD_RSHIFTMEDIA_SLEEPDOWNARROWL"
+    "EFTCTRLKPPLUSKPMINUSMEDIA_NEXTSONGCOMPOSEMOD_RCTRLKP4MOD_LMETASLASHPASTEKP3HANJA"
+    "102NDMEDIA_FINDKP6MEDIA_WWWLEFTBRACEF22MEDIA_VOLUMEDOWNSYSRQRIGHTBRACEPAGEDOWNNU"
+    "MLOCKMEDIA_SCROLLDOWNF18KPCOMMAF1RIGHTMETAMEDIA_SCROLLUPPOWERWINDOWSMOD_RMETASTO"
+    "PMEDIA_STOPCDKP9HOMEF11ESCF6ZENKAKUHANKAKUCOPYCONTROLKPJPCOMMAMEDIA_VOLUMEUPMEDI"
+    "A_COFFEEOPENMEDIA_BACKLEFTALTRIGHTCTRLAGAINUPARROWLEFTARROWRIGHTSHIFTENTERKATAKA"
+    "NAHIRAGANAF5PRINTSCREENHASHTILDEAPPMEDIA_FORWARDMOD_LALTCOMMAFINDBACKSLASHLEFTHA"
+    "NGEULMEDIA_STOPKP8SEMICOLONAPOSTROPHELEFTSHIFTGRAVEKP2PROPS"
+;
+
+const keyname_t keynames[] PROGMEM = {
+    {    0,  4, KEY_UNDO,              KEY_NONE        }, // UNDO
+    {    4,  3, KEY_F10,               KEY_NONE        }, // F10
+    {    7,  8, KEY_MUHENKAN,          KEY_NONE        }, // MUHENKAN
+    {   15,  3, KEY_DOT,               KEY_NONE        }, // DOT
+    {   18,  6, KEY_BACKSPACE,         KEY_NONE        }, // DELETE
+    {   24,  7, KEY_KPENTER,           KEY_NONE        }, // KPENTER
+    {   31, 13, KEY_MEDIA_EJECTCD,     KEY_NONE        }, // MEDIA_EJECTCD
+    {   44,  9, KEY_BACKSPACE,         KEY_NONE        }, // BACKSPACE
+    {   53,  8, KEY_VOLUMEUP,          KEY_NONE        }, // VOLUMEUP
+    {   61,  8, KEY_KATAKANA,          KEY_NONE        }, // KATAKANA
+    {   69,  5, KEY_FRONT,             KEY_NONE        }, // FRONT
+    {   74,  3, KEY_F23,               KEY_NONE        }, // F23
+    {   77,  5, KEY_SPACE,             KEY_NONE        }, // SPACE
+    {   82,  3, KEY_F21,               KEY_NONE        }, // F21
+    {   85,  9, KEY_NONE,              KEY_MOD_LCTRL   }, // MOD_LCTRL
+    {   94,  3, KEY_NONE,              KEY_MOD_LALT    }, // ALT
+    {   97,  8, KEY_CAPSLOCK,          KEY_NONE        }, // CAPSLOCK
+    {  105,  3, KEY_TAB,               KEY_NONE        }, // TAB
+    {  108, 10, KEY_MEDIA_EDIT,        KEY_NONE        }, // MEDIA_EDIT
+    {  118,  5, KEY_PAUSE,             KEY_NONE        }, // BREAK
+    {  123, 10, KEY_MEDIA_CALC,        KEY_NONE        }, // MEDIA_CALC
+    {  133,  4, KEY_MUTE,              KEY_NONE        }, // MUTE
+    {  137,  5, KEY_NONE,              KEY_MOD_LSHIFT  }, // SHIFT
+    {  142,  2, KEY_UP,                KEY_NONE        }, // UP
+    {  144,  3, KEY_F15,               KEY_NONE        }, // F15
+    {  147,  3, KEY_F16,               KEY_NONE        }, // F16
+    {  150,  3, KEY_F13,               KEY_NONE        }, // F13
+    {  153,  8, KEY_NONE,              KEY_MOD_RALT    }, // MOD_RALT
+    {  161,  4, KEY_PROPS,             KEY_NONE        }, // MENU
+    {  165, 10, KEY_VOLUMEDOWN,        KEY_NONE        }, // VOLUMEDOWN
+    {  175, 10, KEY_SCROLLLOCK,        KEY_NONE        }, // SCROLLLOCK
+    {  185, 11, KEY_KPLEFTPAREN,       KEY_NONE        }, // KPLEFTPAREN
+    {  196,  6, KEY_HENKAN,            KEY_NONE        }, // HENKAN
+    {  202,  3, KEY_F24,               KEY_NONE        }, // F24
+    {  205,  4, KEY_DOWN,              KEY_NONE        }, // DOWN
+    {  209,  8, KEY_RIGHTALT,          KEY_NONE        }, // RIGHTALT
+    {  217,  3, KEY_F14,               KEY_NONE        }, // F14
+    {  220,  6, KEY_ESC,               KEY_NONE        }, // ESCAPE
+    {  226,  3, KEY_F20,               KEY_NONE        }, // F20
+    {  229,  5, KEY_RIGHT,             KEY_NONE        }, // RIGHT
+    {  234, 18, KEY_MEDIA_PREVIOUSSONG, KEY_NONE        }, // MEDIA_PREVIOUSSONG
+    {  252, 10, KEY_NONE,              KEY_MOD_LSHIFT  }, // MOD_LSHIFT
+    {  262,  2, KEY_F7,                KEY_NONE        }, // F7
+    {  264,  5, KEY_PAUSE,             KEY_NONE        }, // PAUSE
+    {  269,  3, KEY_F19,               KEY_NONE        }, // F19
+    {  272, 10, KEY_RIGHT,             KEY_NONE        }, // RIGHTARROW
+    {  282, 12, KEY_KPRIGHTPAREN,      KEY_NONE        }, // KPRIGHTPAREN
+    {  294, 13, KEY_MEDIA_REFRESH,     KEY_NONE        }, // MEDIA_REFRESH
+    {  307,  3, KEY_KP5,               KEY_NONE        }, // KP5
+    {  310, 15, KEY_MEDIA_PLAYPAUSE,   KEY_NONE        }, // MEDIA_PLAYPAUSE
+    {  325,  8, KEY_LEFTMETA,          KEY_NONE        }, // LEFTMETA
+    {  333,  2, KEY_F9,                KEY_NONE        }, // F9
+    {  335,  4, KEY_NONE,              KEY_MOD_LCTRL   }, // CTRL
+    {  339,  7, KEY_KPEQUAL,           KEY_NONE        }, // KPEQUAL
+    {  346,  2, KEY_RO,                KEY_NONE        }, // RO
+    {  348,  5, KEY_EQUAL,             KEY_NONE        }, // EQUAL
+    {  353,  2, KEY_F4,                KEY_NONE        }, // F4
+    {  355,  3, KEY_KP7,               KEY_NONE        }, // KP7
+    {  358,  4, KEY_HELP,              KEY_NONE        }, // HELP
+    {  362, 10, KEY_MEDIA_MUTE,        KEY_NONE        }, // MEDIA_MUTE
+    {  372,  2, KEY_F2,                KEY_NONE        }, // F2
+    {  374,  2, KEY_F8,                KEY_NONE        }, // F8
+    {  376,  3, KEY_KP0,               KEY_NONE        }, // KP0
+    {  379,  3, KEY_CUT,               KEY_NONE        }, // CUT
+    {  382,  5, KEY_KPDOT,             KEY_NONE        }, // KPDOT
+    {  387,  6, KEY_INSERT,            KEY_NONE        }, // INSERT
+    {  393,  8, KEY_HIRAGANA,          KEY_NONE        }, // HIRAGANA
+    {  401,  6, KEY_PAGEUP,            KEY_NONE        }, // PAGEUP
+    {  407,  5, KEY_MINUS,             KEY_NONE        }, // MINUS
+    {  412,  7, KEY_KPSLASH,           KEY_NONE        }, // KPSLASH
+    {  419,  3, KEY_KP1,               KEY_NONE        }, // KP1
+    {  422,  3, KEY_F17,               KEY_NONE        }, // F17
+    {  425,  3, KEY_YEN,               KEY_NONE        }, // YEN
+    {  428, 10, KEY_KPASTERISK,        KEY_NONE        }, // KPASTERISK
+    {  438,  3, KEY_END,               KEY_NONE        }, // END
+    {  441,  2, KEY_F3,                KEY_NONE        }, // F3
+    {  443,  3, KEY_F12,               KEY_NONE        }, // F12
+    {  446,  3, KEY_NONE,              KEY_MOD_LMETA   }, // GUI
+    {  449, 10, KEY_NONE,              KEY_MOD_RSHIFT  }, // MOD_RSHIFT
+    {  459, 11, KEY_MEDIA_SLEEP,       KEY_NONE        }, // MEDIA_SLEEP
+    {  470,  9, KEY_DOWN,              KEY_NONE        }, // DOWNARROW
+    {  479,  8, KEY_LEFTCTRL,          KEY_NONE        }, // LEFTCTRL
+    {  487,  6, KEY_KPPLUS,            KEY_NONE        }, // KPPLUS
+    {  493,  7, KEY_KPMINUS,           KEY_NONE        }, // KPMINUS
+    {  500, 14, KEY_MEDIA_NEXTSONG,    KEY_NONE        }, // MEDIA_NEXTSONG
+    {  514,  7, KEY_COMPOSE,           KEY_NONE        }, // COMPOSE
+    {  521,  9, KEY_NONE,              KEY_MOD_RCTRL   }, // MOD_RCTRL
+    {  530,  3, KEY_KP4,               KEY_NONE        }, // KP4
+    {  533,  9, KEY_NONE,              KEY_MOD_LMETA   }, // MOD_LMETA
+    {  542,  5, KEY_SLASH,             KEY_NONE        }, // SLASH
+    {  547,  5, KEY_PASTE,             KEY_NONE        }, // PASTE
+    {  552,  3, KEY_KP3,               KEY_NONE        }, // KP3
+    {  555,  5, KEY_HANJA,             KEY_NONE        }, // HANJA
+    {  560,  5, KEY_102ND,             KEY_NONE        }, // 102ND
+    {  565, 10, KEY_MEDIA_FIND,        KEY_NONE        }, // MEDIA_FIND
+    {  575,  3, KEY_KP6,               KEY_NONE        }, // KP6
+    {  578,  9, KEY_MEDIA_WWW,         KEY_NONE        }, // MEDIA_WWW
+    {  587,  9, KEY_LEFTBRACE,         KEY_NONE        }, // LEFTBRACE
+    {  596,  3, KEY_F22,               KEY_NONE        }, // F22
+    {  599, 16, KEY_MEDIA_VOLUMEDOWN,  KEY_NONE        }, // MEDIA_VOLUMEDOWN
+    {  615,  5, KEY_SYSRQ,             KEY_NONE        }, // SYSRQ
+    {  620, 10, KEY_RIGHTBRACE,        KEY_NONE        }, // RIGHTBRACE
+    {  630,  8, KEY_PAGEDOWN,          KEY_NONE        }, // PAGEDOWN
+    {  638,  7, KEY_NUMLOCK,           KEY_NONE        }, // NUMLOCK
+    {  645, 16, KEY_MEDIA_SCROLLDOWN,  KEY_NONE        }, // MEDIA_SCROLLDOWN
+    {  661,  3, KEY_F18,               KEY_NONE        }, // F18
+    {  664,  7, KEY_KPCOMMA,           KEY_NONE        }, // KPCOMMA
+    {  671,  2, KEY_F1,                KEY_NONE        }, // F1
+    {  673,  9, KEY_RIGHTMETA,         KEY_NONE        }, // RIGHTMETA
+    {  682, 14, KEY_MEDIA_SCROLLUP,    KEY_NONE        }, // MEDIA_SCROLLUP
+    {  696,  5, KEY_POWER,             KEY_NONE        }, // POWER
+    {  701,  7, KEY_NONE,              KEY_MOD_LMETA   }, // WINDOWS
+    {  708,  9, KEY_NONE,              KEY_MOD_RMETA   }, // MOD_RMETA
+    {  717,  4, KEY_STOP,              KEY_NONE        }, // STOP
+    {  721, 12, KEY_MEDIA_STOPCD,      KEY_NONE        }, // MEDIA_STOPCD
+    {  733,  3, KEY_KP9,               KEY_NONE        }, // KP9
+    {  736,  4, KEY_HOME,              KEY_NONE        }, // HOME
+    {  740,  3, KEY_F11,               KEY_NONE        }, // F11
+    {  743,  3, KEY_ESC,               KEY_NONE        }, // ESC
+    {  746,  2, KEY_F6,                KEY_NONE        }, // F6
+    {  748, 14, KEY_ZENKAKUHANKAKU,    KEY_NONE        }, // ZENKAKUHANKAKU
+    {  762,  4, KEY_COPY,              KEY_NONE        }, // COPY
+    {  766,  7, KEY_NONE,              KEY_MOD_LCTRL   }, // CONTROL
+    {  773,  9, KEY_KPJPCOMMA,         KEY_NONE        }, // KPJPCOMMA
+    {  782, 14, KEY_MEDIA_VOLUMEUP,    KEY_NONE        }, // MEDIA_VOLUMEUP
+    {  796, 12, KEY_MEDIA_COFFEE,      KEY_NONE        }, // MEDIA_COFFEE
+    {  808,  4, KEY_OPEN,              KEY_NONE        }, // OPEN
+    {  812, 10, KEY_MEDIA_BACK,        KEY_NONE        }, // MEDIA_BACK
+    {  822,  7, KEY_LEFTALT,           KEY_NONE        }, // LEFTALT
+    {  829,  9, KEY_RIGHTCTRL,         KEY_NONE        }, // RIGHTCTRL
+    {  838,  5, KEY_AGAIN,             KEY_NONE        }, // AGAIN
+    {  843,  7, KEY_UP,                KEY_NONE        }, // UPARROW
+    {  850,  9, KEY_LEFT,              KEY_NONE        }, // LEFTARROW
+    {  859, 10, KEY_RIGHTSHIFT,        KEY_NONE        }, // RIGHTSHIFT
+    {  869,  5, KEY_ENTER,             KEY_NONE        }, // ENTER
+    {  874, 16, KEY_KATAKANAHIRAGANA,  KEY_NONE        }, // KATAKANAHIRAGANA
+    {  890,  2, KEY_F5,                KEY_NONE        }, // F5
+    {  892, 11, KEY_SYSRQ,             KEY_NONE        }, // PRINTSCREEN
+    {  903,  9, KEY_HASHTILDE,         KEY_NONE        }, // HASHTILDE
+    {  912,  3, KEY_PROPS,             KEY_NONE        }, // APP
+    {  915, 13, KEY_MEDIA_FORWARD,     KEY_NONE        }, // MEDIA_FORWARD
+    {  928,  8, KEY_NONE,              KEY_MOD_LALT    }, // MOD_LALT
+    {  936,  5, KEY_COMMA,             KEY_NONE        }, // COMMA
+    {  941,  4, KEY_FIND,              KEY_NONE        }, // FIND
+    {  945,  9, KEY_BACKSLASH,         KEY_NONE        }, // BACKSLASH
+    {  954,  4, KEY_LEFT,              KEY_NONE        }, // LEFT
+    {  958,  7, KEY_HANGEUL,           KEY_NONE        }, // HANGEUL
+    {  965, 10, KEY_MEDIA_STOP,        KEY_NONE        }, // MEDIA_STOP
+    {  975,  3, KEY_KP8,               KEY_NONE        }, // KP8
+    {  978,  9, KEY_SEMICOLON,         KEY_NONE        }, // SEMICOLON
+    {  987, 10, KEY_APOSTROPHE,        KEY_NONE        }, // APOSTROPHE
+    {  997,  9, KEY_LEFTSHIFT,         KEY_NONE        }, // LEFTSHIFT
+    { 1006,  5, KEY_GRAVE,             KEY_NONE        }, // GRAVE
+    { 1011,  3, KEY_KP2,               KEY_NONE        }, // KP2
+    { 1014,  5, KEY_PROPS,             KEY_NONE        }, // PROPS
+};
@@ -0,0 +1,34 @@
+/*
+   This software is licensed under the MIT License. See the license file for details.
+   Source: https://github.com/spacehuhntech/WiFiDuck
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include "locales/locales.h"
+
+#define LAYOUT_EXTENSION ".layout"
+#define LAYOUT_MAGIC "LAYT"
+#define LAYOUT_VERSION 1
+#define LAYOUT_NAME_LEN 16
+
+// A layout file is written by scripts/locales.py --bin, it contains
+// header_t, keys_len keys, 128 packed ascii characters,
+// extended_ascii_len uint16 and utf8_len uint32 entries like in hid_locale_t.
+// LOCALE NAME loads /NAME.layout, the name is case sensitive like the file name
+namespace layouts {
+    typedef struct header_t {
+        char     magic[4];
+        uint8_t  version;
+        uint8_t  keys_len;
+        uint16_t extended_ascii_len;
+        uint16_t utf8_len;
+        uint8_t  reserved[2];
+    } header_t;
+
+    hid_locale_t* get(const char* name, size_t len);
+
+    void invalidate(String fileName);
+    void clearCache();
+}
@@ -5,13 +5,22 @@
 
 #pragma once
 
+// A character is packed into one byte,
+// the index of its key in locale_keys and the modifiers in the high bits
+#define LOCALE_KEY_MASK 0x3F
+#define LOCALE_SHIFT 0x40
+#define LOCALE_ALTGR 0x80
+
 typedef struct hid_locale_t {
-    uint8_t* ascii;
-    uint8_t  ascii_len;
+    const char*    name;
+    const uint8_t* keys; // Key of every index of a packed character
+
+    const uint8_t* ascii; // Packed character of every ascii code
+    uint8_t        ascii_len;
 
-    uint8_t* extended_ascii;
-    size_t   extended_ascii_len;
+    const uint16_t* extended_ascii; // Packed character << 8 | code, sorted by code
+    size_t          extended_ascii_len;
 
-    uint8_t* utf8;
-    size_t   utf8_len;
-} hid_locale_t;
\ No newline at end of file
+    const uint32_t* utf8; // Packed character << 24 | codepoint, sorted by codepoint
+    size_t          utf8_len;
+} hid_locale_t;
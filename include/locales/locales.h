@@ -3,15 +3,25 @@
    Source: https://github.com/spacehuhntech/WiFiDuck
  */
 
+// Generated by scripts/locales.py from scripts/layouts.txt, do not edit!
+
 #pragma once
 
 #include "usb_hid_keys.h"
 #include "locale_types.h"
 
-#include "locale_us.h"
-#include "locale_de.h"
-#include "locale_gb.h"
-#include "locale_es.h"
-#include "locale_fr.h"
-#include "locale_ru.h"
-#include "locale_dk.h"
+#define LOCALE_KEYS_LEN 54
+#define LOCALES_LEN 7
+
+// Key of every index of a packed character
+extern const uint8_t locale_keys[LOCALE_KEYS_LEN];
+
+extern hid_locale_t locale_us;
+extern hid_locale_t locale_de;
+extern hid_locale_t locale_gb;
+extern hid_locale_t locale_es;
+extern hid_locale_t locale_fr;
+extern hid_locale_t locale_ru;
+extern hid_locale_t locale_dk;
+
+extern hid_locale_t* const locales[LOCALES_LEN];
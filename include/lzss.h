@@ -0,0 +1,52 @@
+/*
+   This software is licensed under the MIT License. See the license file for details.
+   Source: https://github.com/spacehuhntech/WiFiDuck
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <FS.h> // File
+
+#define DUCKZ_EXTENSION ".duckz"
+#define DUCKZ_MAGIC "DUKZ"
+#define DUCKZ_VERSION 1
+#define LZSS_INPUT_SIZE 32 // Compressed bytes that are read at once
+
+// A compressed script is written by scripts/compress.py, it contains header_t
+// and the script compressed in the format of heatshrink: a 1 bit is followed by
+// a literal byte, a 0 bit by the offset (window_bits) and length (lookahead_bits)
+// of a match in the last 2^window_bits bytes, both stored minus 1, MSB first
+namespace lzss {
+    typedef struct header_t {
+        char     magic[4];
+        uint8_t  version;
+        uint8_t  window_bits;
+        uint8_t  lookahead_bits;
+        uint8_t  reserved;
+        uint32_t size; // Size of the uncompressed script
+    } header_t;
+
+    typedef struct decoder_t {
+        header_t h;
+        uint8_t* window;   // Last 2^window_bits bytes of output
+        uint16_t head;     // Where the next byte of output goes in window
+        uint32_t out;      // Bytes of output so far
+        uint16_t copyLen;  // Bytes of the current match that are left
+        uint16_t copyFrom; // Distance of the current match
+        uint8_t  in[LZSS_INPUT_SIZE];
+        uint8_t  inLen;
+        uint8_t  inI;
+        uint8_t  bitMask; // Next bit of in[inI - 1]
+        bool     eof;     // The compressed data ended before the script, the file is truncated
+    } decoder_t;
+
+    decoder_t* open(File& f);
+    void close(decoder_t* d);
+    void rewind(decoder_t* d, File& f);
+
+    size_t decode(decoder_t* d, File& f, uint8_t* dst, size_t len);
+    bool done(decoder_t* d);
+
+    bool readHeader(File& f, header_t& h);
+}
@@ -0,0 +1,49 @@
+/*
+   This software is licensed under the MIT License. See the license file for details.
+   Source: https://github.com/spacehuhntech/WiFiDuck
+ */
+
+#pragma once
+
+#include <Arduino.h> // Print
+
+#define PROTOCOL_VERSION 1
+
+#define PROTOCOL_HELLO 0x00  // version (1 byte) -> version (1 byte), largest response (uint32)
+#define PROTOCOL_RUN 0x01    // file ->
+#define PROTOCOL_STOP 0x02   // [file] ->, without a file everything is stopped
+#define PROTOCOL_STATUS 0x03 // -> state (1 byte), name, line or received (uint32), size (uint32)
+#define PROTOCOL_LS 0x04     // directory -> name, size (uint32), uncompressed size (uint32) per file
+#define PROTOCOL_READ 0x05   // file, offset (uint32), length (uint32) -> size of the file (uint32), data
+#define PROTOCOL_WRITE 0x06  // file, offset (uint32), data -> size of the file (uint32)
+
+#define PROTOCOL_REQUEST_HEADER_SIZE 3  // Opcode and id
+#define PROTOCOL_RESPONSE_HEADER_SIZE 4 // Opcode, id and status
+#define PROTOCOL_RESPONSE 0x80          // Set in the opcode of a response
+
+#define PROTOCOL_OK 0    // Last part of a response
+#define PROTOCOL_ERROR 1 // The only field is the error message
+#define PROTOCOL_PART 2  // More parts with the same id follow
+
+#define PROTOCOL_IDLE 0
+#define PROTOCOL_RUNNING 1
+#define PROTOCOL_REPLAYING 2
+#define PROTOCOL_UPLOADING 3
+
+// Binary requests over the web socket, so a client can send many of them
+// at once and match the responses by their id instead of parsing text.
+// A client starts with PROTOCOL_HELLO, before that its binary frames are
+// only chunks of uploads. Every request is one frame of at most PROTOCOL_FRAME_SIZE bytes,
+// larger ones are answered with an error:
+//   opcode (1 byte), id (uint16), fields
+// and is answered with one or more frames of at most PROTOCOL_FRAME_SIZE bytes:
+//   opcode | PROTOCOL_RESPONSE, id (uint16), status (1 byte), fields
+// A field is its length (uint16) followed by its data, numbers are
+// little endian and strings aren't terminated.
+// An offset of a write must be 0, which replaces the file, or its size.
+namespace protocol {
+    void end();
+
+    void handle(const uint8_t* data, size_t len, Print& out);
+    void receive(const uint8_t* data, size_t len, size_t index, size_t total, Print& out);
+}
@@ -0,0 +1,39 @@
+/*
+   This software is licensed under the MIT License. See the license file for details.
+   Source: https://github.com/spacehuhntech/WiFiDuck
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <FS.h> // File
+
+#include "config.h" // BUFFER_SIZE
+#include "lzss.h"
+
+// Reads a file in blocks of BUFFER_SIZE bytes, so the file system
+// isn't asked for every byte. buf[i] to buf[len] is what wasn't read yet.
+// Compressed files are decompressed, positions are the ones of the uncompressed data.
+namespace reader {
+    typedef struct reader_t {
+        File   file;
+        char   buf[BUFFER_SIZE];
+        size_t len; // Bytes in buf
+        size_t i;   // Bytes of buf that were read
+        lzss::decoder_t* decoder; // Only for compressed files
+    } reader_t;
+
+    void begin(reader_t& r, File file);
+    void close(reader_t& r);
+
+    bool fill(reader_t& r);
+    bool last(reader_t& r);
+    size_t available(reader_t& r);
+
+    const uint8_t* peek(reader_t& r, size_t n);
+    size_t read(reader_t& r, uint8_t* dst, size_t n);
+    size_t readUntil(reader_t& r, char* dst, char delimiter, size_t max_len);
+
+    uint32_t position(reader_t& r);
+    void seek(reader_t& r, uint32_t pos);
+}
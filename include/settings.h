@@ -5,7 +5,7 @@
 
 #pragma once
 
-#include <Arduino.h> // String
+#include <Arduino.h> // Print
 
 namespace settings {
     void begin();
@@ -14,7 +14,7 @@ namespace settings {
     void reset();
     void save();
 
-    String toString();
+    void print(Print& out);
 
     const char* getSSID();
     const char* getPassword();
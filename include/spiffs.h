@@ -8,9 +8,12 @@
 #include <Arduino.h> // String
 #include <FS.h>      // File
 
+// LittleFS, or SPIFFS when STORAGE_LITTLEFS is false
+// or the files of an older version didn't fit into RAM for moving them to LittleFS
 namespace spiffs {
     void begin();
     void format();
+    const char* name();
 
     size_t size();
     size_t usedBytes();
@@ -19,15 +22,39 @@ namespace spiffs {
     size_t size(String fileName);
     bool exists(String fileName);
 
-    File open(String fileName);
+    File openRead(String fileName);
+    File openWrite(String fileName);
+    File openAppend(String fileName);
+    File openPooled(String fileName);
     void create(String fileName);
 
     void remove(String fileName);
-    void rename(String oldName, String newName);
+    bool rename(String oldName, String newName);
     void write(String fileName, const char* str);
     void write(String fileName, const uint8_t* buf, size_t len);
 
-    String listDir(String dirName);
+    // Passes every file with its size and the size of it uncompressed
+    typedef void (* FileFunction)(const String& name, size_t size, size_t logical);
+
+    void listDir(String dirName, Print& out);
+    void eachFile(String dirName, FileFunction f);
+    void compressedBytes(size_t& compressed, size_t& uncompressed);
+    void invalidate();
+
+    // Result of a benchmark, times in us and throughput in KB/s
+    typedef struct bench_t {
+        uint32_t open;
+        uint32_t pooled; // Open from the pool
+        uint32_t read;
+        uint32_t write;
+        size_t   bytes;  // Size of the file that was read and written
+        uint32_t list;
+        uint32_t cached; // ls from the index
+        size_t   files;
+    } bench_t;
+
+    void benchmark(bench_t& b);
+    String benchmark();
 
     void streamOpen(String fileName);
     void streamWrite(const char* buf, size_t len);
@@ -0,0 +1,42 @@
+/*
+   This software is licensed under the MIT License. See the license file for details.
+   Source: https://github.com/spacehuhntech/WiFiDuck
+ */
+
+#pragma once
+
+#include <Arduino.h> // String
+
+#define TRACE_MAGIC "HIDT"
+#define TRACE_VERSION 1
+#define TRACE_REPORT_SIZE 8
+
+// A trace file is a header_t followed by a record_t for every report
+// that was written to the CH9328, in the order they were sent
+namespace tracer {
+    typedef struct header_t {
+        char    magic[4];
+        uint8_t version;
+        uint8_t reserved[3];
+    } header_t;
+
+    typedef struct record_t {
+        uint32_t time; // Time since the trace started (us)
+        uint8_t  report[TRACE_REPORT_SIZE];
+    } record_t;
+
+    void start(String fileName);
+    void stop();
+    bool tracing();
+
+    void record(const uint8_t* report);
+    uint32_t getRecorded();
+    uint32_t getDropped();
+
+    void replay(String fileName);
+    void stopReplay();
+    bool replaying();
+    String currentReplay();
+
+    void update();
+}
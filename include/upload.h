@@ -0,0 +1,40 @@
+/*
+   This software is licensed under the MIT License. See the license file for details.
+   Source: https://github.com/spacehuhntech/WiFiDuck
+ */
+
+#pragma once
+
+#include <Arduino.h> // String
+
+#define UPLOAD_MAGIC 'U'
+#define UPLOAD_HEADER_SIZE 9 // Magic, offset and crc32 of a chunk
+#define UPLOAD_EXTENSION ".part"
+
+// Uploads a file over the web socket:
+// 1. "upload <file> <size> <crc32>" (crc32 in hex) is answered with
+//    "> upload <offset> <window>". The offset is where an upload of the same
+//    file stopped before, so a dropped connection doesn't start from 0 again.
+// 2. Binary frames of up to UPLOAD_CHUNK_SIZE bytes of data, each starting with
+//    UPLOAD_MAGIC, the offset (uint32) and the crc32 (uint32) of its data.
+//    Every frame is answered with "> ack <offset>", the offset that's expected next.
+//    Chunks at another offset or with the wrong crc32 are dropped, they have
+//    to be sent again from there. Up to window bytes may be sent after the last ack.
+// 3. The last chunk is answered with "> uploaded <file>" when the crc32 of the whole
+//    file matched, the data is written to <file>.part and only then renamed to <file>.
+// Only the client that started the upload can send chunks. When it disconnects the
+// upload is paused, then any client can continue it with the same upload command.
+namespace upload {
+    String start(String fileName, uint32_t size, uint32_t crc, uint32_t client);
+    String receive(const uint8_t* data, size_t len, size_t index, size_t total, uint32_t client);
+    void pause();
+    void cancel();
+
+    bool uploading();
+    String currentUpload();
+    uint32_t getReceived();
+    uint32_t getSize();
+    uint32_t getClient();
+
+    uint32_t crc32(const uint8_t* data, size_t len, uint32_t crc = 0);
+}
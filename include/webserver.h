@@ -5,8 +5,19 @@
 
 #pragma once
 
+#include <Arduino.h> // Print, uint32_t
+
 namespace webserver {
     void begin();
     void update();
-    void send(const char* str);
+
+    // Writes output for a client outside of its callback, 0 is the debug output
+    typedef void (* OutputFunction)(Print& out);
+
+    uint32_t currentClientId();
+    void print(uint32_t clientId, OutputFunction f);
+
+    bool ping(uint32_t clientId);
+    bool pinging();
+    uint32_t getRoundTrip();
 }
\ No newline at end of file
@@ -0,0 +1,137 @@
+/*
+   This software is licensed under the MIT License. See the license file for details.
+   Source: https://github.com/spacehuhntech/WiFiDuck
+ */
+
+#pragma once
+
+// Host replacement for the parts of the Arduino/ESP8266 core the script engine uses.
+// Only compiled for [env:native], see platformio.ini.
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <string>
+#include <algorithm>
+
+#define PROGMEM
+#define PGM_P const char*
+#define PSTR(s) (s)
+#define F(s) (s)
+#define pgm_read_byte(addr) (*(const uint8_t*)(addr))
+#define pgm_read_word(addr) (*(const uint16_t*)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t*)(addr))
+#define memcpy_P memcpy
+#define strlen_P strlen
+#define _min(a, b) ((a) < (b) ? (a) : (b))
+#define _max(a, b) ((a) > (b) ? (a) : (b))
+#define OUTPUT 1
+#define INPUT 0
+
+// ===== Time ===== //
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void yield();
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+
+namespace native {
+    // Moves millis() forward, so DELAYs can be skipped without waiting
+    void advanceTime(unsigned long ms);
+}
+
+// ===== String ===== //
+class String {
+    std::string s;
+public:
+    String() {}
+    String(const char* c) : s(c ? c : "") {}
+    String(const std::string& c) : s(c) {}
+    String(char c) : s(1, c) {}
+    String(int v) : s(std::to_string(v)) {}
+    String(unsigned int v) : s(std::to_string(v)) {}
+    String(long v) : s(std::to_string(v)) {}
+    String(unsigned long v) : s(std::to_string(v)) {}
+    String(float v, unsigned int d = 2) { char b[32]; snprintf(b, sizeof(b), "%.*f", d, v); s = b; }
+    String(double v, unsigned int d = 2) { char b[32]; snprintf(b, sizeof(b), "%.*f", d, v); s = b; }
+    const char* c_str() const { return s.c_str(); }
+    unsigned int length() const { return s.size(); }
+    void reserve(size_t n) { s.reserve(n); }
+    bool startsWith(const String& p) const { return s.compare(0, p.s.size(), p.s) == 0; }
+    bool endsWith(const String& p) const { return s.size() >= p.s.size() && s.compare(s.size() - p.s.size(), p.s.size(), p.s) == 0; }
+    int indexOf(char c, unsigned int from = 0) const { size_t i = s.find(c, from); return i == std::string::npos ? -1 : (int)i; }
+    int lastIndexOf(char c) const { size_t i = s.rfind(c); return i == std::string::npos ? -1 : (int)i; }
+    String substring(unsigned int a) const { return a >= s.size() ? String() : String(s.substr(a)); }
+    String substring(unsigned int a, unsigned int b) const { if (a >= s.size() || b <= a) return String(); return String(s.substr(a, b - a)); }
+    long toInt() const { return atol(s.c_str()); }
+    char charAt(unsigned int i) const { return i < s.size() ? s[i] : 0; }
+    char operator[](unsigned int i) const { return charAt(i); }
+    String& operator+=(const String& o) { s += o.s; return *this; }
+    String& operator+=(const char* o) { s += o ? o : ""; return *this; }
+    String& operator+=(char c) { s += c; return *this; }
+    String& operator+=(int v) { s += std::to_string(v); return *this; }
+    String& operator+=(unsigned int v) { s += std::to_string(v); return *this; }
+    String& operator+=(long v) { s += std::to_string(v); return *this; }
+    String& operator+=(unsigned long v) { s += std::to_string(v); return *this; }
+    bool concat(const char* c, unsigned int n) { s.append(c, n); return true; }
+    friend String operator+(const String& a, const String& b) { return String(a.s + b.s); }
+    friend String operator+(const String& a, const char* b) { return String(a.s + (b ? b : "")); }
+    friend String operator+(const char* a, const String& b) { return String(std::string(a ? a : "") + b.s); }
+    friend String operator+(const String& a, char b) { return String(a.s + b); }
+    bool operator==(const String& o) const { return s == o.s; }
+    bool operator==(const char* o) const { return s == (o ? o : ""); }
+    bool operator!=(const String& o) const { return s != o.s; }
+    bool operator<(const String& o) const { return s < o.s; }
+};
+
+// ===== Print/Stream ===== //
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t* buf, size_t len) { size_t n = 0; while (len--) n += write(*buf++); return n; }
+    size_t write(const char* str) { return str ? write((const uint8_t*)str, strlen(str)) : 0; }
+    size_t write(const char* buf, size_t len) { return write((const uint8_t*)buf, len); }
+    size_t print(const char* s) { return write(s); }
+    size_t print(const String& s) { return write(s.c_str()); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(int v) { return print(String(v)); }
+    size_t print(unsigned int v) { return print(String(v)); }
+    size_t print(long v) { return print(String(v)); }
+    size_t print(unsigned long v) { return print(String(v)); }
+    size_t println() { return write('\n'); }
+    template<typename T> size_t println(const T& v) { size_t n = print(v); return n + println(); }
+    size_t printf(const char* fmt, ...) { char b[512]; va_list a; va_start(a, fmt); int n = vsnprintf(b, sizeof(b), fmt, a); va_end(a); return write((const uint8_t*)b, n < 0 ? 0 : _min((size_t)n, sizeof(b) - 1)); }
+    virtual void flush() {}
+};
+
+class Stream : public Print {
+public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+};
+
+// Everything written to Serial is captured, that's what would go to the CH9328
+class HardwareSerial : public Stream {
+public:
+    std::string captured;
+    size_t tx_bytes { 0 };
+    void begin(unsigned long) {}
+    void updateBaudRate(unsigned long) {}
+    void setTimeout(unsigned long) {}
+    size_t write(uint8_t c) override { captured += (char)c; ++tx_bytes; return 1; }
+    size_t write(const uint8_t* buf, size_t len) override { captured.append((const char*)buf, len); tx_bytes += len; return len; }
+    using Print::write;
+    int availableForWrite() { return 128; }
+    int available() override { return 0; }
+    int read() override { return -1; }
+    int peek() override { return -1; }
+    String readStringUntil(char) { return String(); }
+    void clear() { captured.clear(); }
+};
+
+extern HardwareSerial Serial;
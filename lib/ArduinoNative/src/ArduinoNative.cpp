@@ -0,0 +1,107 @@
+/*
+   This software is licensed under the MIT License. See the license file for details.
+   Source: https://github.com/spacehuhntech/WiFiDuck
+ */
+
+#include "Arduino.h"
+#include "FS.h"
+#include <chrono>
+#include <sys/stat.h>
+#include <dirent.h>
+#include <unistd.h>
+#include "user_interface.h"
+
+HardwareSerial Serial;
+
+static auto start_time = std::chrono::steady_clock::now();
+static unsigned long time_offset = 0; // Simulated time in microseconds
+
+// ===== Time ===== //
+unsigned long micros() {
+    return (unsigned long)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start_time).count() + time_offset;
+}
+unsigned long millis() {
+    return micros() / 1000;
+}
+// Nothing on the host has to wait for real, so waiting only moves the time forward
+void delay(unsigned long ms) { time_offset += ms * 1000; }
+void yield() { time_offset += 100; }
+void pinMode(uint8_t, uint8_t) {}
+void digitalWrite(uint8_t, uint8_t) {}
+
+namespace native {
+    void advanceTime(unsigned long ms) { time_offset += ms * 1000; }
+}
+
+// ===== File system ===== //
+namespace fs {
+    static void mkdirs(const std::string& path) {
+        for (size_t i = 1; i < path.size(); ++i) {
+            if (path[i] == '/') mkdir(path.substr(0, i).c_str(), 0755);
+        }
+    }
+
+    static void walk(const std::string& base, const std::string& rel, std::vector<std::string>& out) {
+        DIR* d = opendir((base + rel).c_str());
+        if (!d) return;
+        while (dirent* e = readdir(d)) {
+            std::string n = e->d_name;
+            if (n == "." || n == "..") continue;
+            std::string r = rel + "/" + n;
+            struct stat st;
+            if (stat((base + r).c_str(), &st) == 0 && S_ISDIR(st.st_mode)) walk(base, r, out);
+            else out.push_back(r);
+        }
+        closedir(d);
+    }
+
+    bool File::truncate(uint32_t size) { return fp() && ftruncate(fileno(fp()), size) == 0; }
+    time_t File::getLastWrite() { struct stat st; return (fp() && fstat(fileno(fp()), &st) == 0) ? st.st_mtime : 0; }
+
+    Dir::Dir(const std::string& root, const std::string& prefix) : root(root), prefix(prefix), entries(new std::vector<std::string>()) {
+        std::vector<std::string> all;
+        walk(root, "", all);
+        std::sort(all.begin(), all.end());
+        for (auto& e : all) if (e.compare(0, prefix.size(), prefix) == 0) entries->push_back(e);
+    }
+    Dir::Dir(const Dir& o) : root(o.root), prefix(o.prefix), entries(o.entries ? new std::vector<std::string>(*o.entries) : nullptr), i(o.i), current(o.current) {}
+    Dir& Dir::operator=(const Dir& o) { if (this != &o) { delete entries; root = o.root; prefix = o.prefix; entries = o.entries ? new std::vector<std::string>(*o.entries) : nullptr; i = o.i; current = o.current; } return *this; }
+    Dir::~Dir() { delete entries; }
+    bool Dir::next() { if (!entries || i >= entries->size()) return false; current = (*entries)[i++]; return true; }
+    size_t Dir::fileSize() const { struct stat st; return stat((root + current).c_str(), &st) == 0 ? st.st_size : 0; }
+    File Dir::openFile(const char* mode) { FILE* fp = fopen((root + current).c_str(), mode); return File(fp, root + current, current); }
+
+    bool FS::begin() { mkdirs(root + "/"); mkdir(root.c_str(), 0755); return true; }
+    bool FS::format() { std::vector<std::string> all; walk(root, "", all); for (auto& e : all) ::remove((root + e).c_str()); return true; }
+    bool FS::info(FSInfo& info) {
+        std::vector<std::string> all; walk(root, "", all);
+        size_t used = 0; struct stat st;
+        for (auto& e : all) if (stat((root + e).c_str(), &st) == 0) used += st.st_size;
+        info.totalBytes = total; info.usedBytes = used; info.blockSize = 4096; info.pageSize = 256; info.maxOpenFiles = 5; info.maxPathLength = 32;
+        return true;
+    }
+    File FS::open(const String& path, const char* mode) {
+        std::string p = root + path.c_str();
+        const char* m = mode;
+        if (strcmp(mode, "r") == 0) m = "rb";
+        else if (strcmp(mode, "w") == 0) m = "wb";
+        else if (strcmp(mode, "a") == 0) m = "ab";
+        else if (strcmp(mode, "a+") == 0) m = "a+b";
+        else if (strcmp(mode, "r+") == 0) m = "r+b";
+        else if (strcmp(mode, "w+") == 0) m = "w+b";
+        if (m[0] != 'r') mkdirs(p);
+        FILE* fp = fopen(p.c_str(), m);
+        if (fp && m[0] == 'a') fseek(fp, 0, SEEK_SET);
+        return File(fp, p, path.c_str());
+    }
+    bool FS::exists(const String& path) { struct stat st; return stat((root + path.c_str()).c_str(), &st) == 0; }
+    bool FS::remove(const String& path) { return ::remove((root + path.c_str()).c_str()) == 0; }
+    bool FS::rename(const String& a, const String& b) { mkdirs(root + b.c_str()); return ::rename((root + a.c_str()).c_str(), (root + b.c_str()).c_str()) == 0; }
+    Dir FS::openDir(const String& path) { return Dir(root, path.c_str()); }
+}
+
+// Relative to the working directory, which is the project when started by PlatformIO
+FS SPIFFS(".pio/native_fs/spiffs", 1024 * 1024);
+FS LittleFS(".pio/native_fs/littlefs", 1024 * 1024);
+
+extern "C" uint32_t system_get_free_heap_size(void) { return 40000; }
@@ -0,0 +1,113 @@
+/*
+   This software is licensed under the MIT License. See the license file for details.
+   Source: https://github.com/spacehuhntech/WiFiDuck
+ */
+
+#pragma once
+
+// SPIFFS and LittleFS on the host, every file system is a directory.
+#include "Arduino.h"
+#include <time.h>
+#include <vector>
+#include <memory>
+
+enum SeekMode { SeekSet = 0, SeekCur = 1, SeekEnd = 2 };
+
+struct FSInfo {
+    size_t totalBytes;
+    size_t usedBytes;
+    size_t blockSize;
+    size_t pageSize;
+    size_t maxOpenFiles;
+    size_t maxPathLength;
+};
+
+namespace fs {
+    class FSConfig {
+    public:
+        FSConfig& setAutoFormat(bool) { return *this; }
+    };
+
+    // Closed when the last copy is gone, like on the ESP8266
+    class File : public Stream {
+        std::shared_ptr<FILE> file;
+        std::string path;
+        std::string fname;
+        FILE* fp() const { return file.get(); }
+    public:
+        File() {}
+        File(FILE* fp, const std::string& path, const std::string& name) : file(fp, [](FILE* f) { if (f) fclose(f); }), path(path), fname(name) {}
+        size_t write(uint8_t c) override { return write(&c, 1); }
+        size_t write(const uint8_t* buf, size_t len) override { return fp() ? fwrite(buf, 1, len, fp()) : 0; }
+        using Print::write;
+        int available() override { if (!fp()) return 0; long p = ftell(fp()); fseek(fp(), 0, SEEK_END); long e = ftell(fp()); fseek(fp(), p, SEEK_SET); return (int)(e - p); }
+        int read() override { if (!fp()) return -1; int c = fgetc(fp()); return c == EOF ? -1 : c; }
+        size_t read(uint8_t* buf, size_t len) { return fp() ? fread(buf, 1, len, fp()) : 0; }
+        size_t readBytes(char* buf, size_t len) { return read((uint8_t*)buf, len); }
+        int peek() override { if (!fp()) return -1; int c = fgetc(fp()); if (c != EOF) ungetc(c, fp()); return c == EOF ? -1 : c; }
+        bool seek(uint32_t pos, SeekMode mode = SeekSet) { return fp() && fseek(fp(), pos, mode == SeekSet ? SEEK_SET : mode == SeekCur ? SEEK_CUR : SEEK_END) == 0; }
+        size_t position() const { return fp() ? ftell(fp()) : 0; }
+        size_t size() const { if (!fp()) return 0; long p = ftell(fp()); fseek(fp(), 0, SEEK_END); long e = ftell(fp()); fseek(fp(), p, SEEK_SET); return e; }
+        bool truncate(uint32_t);
+        void flush() override { if (fp()) fflush(fp()); }
+        void close() { file.reset(); }
+        time_t getLastWrite();
+        const char* name() const { return fname.c_str(); }
+        const char* fullName() const { return fname.c_str(); }
+        bool isFile() const { return fp() != nullptr; }
+        operator bool() const { return fp() != nullptr; }
+    };
+
+    class Dir {
+        std::string root;
+        std::string prefix;
+        std::vector<std::string>* entries { nullptr };
+        size_t i { 0 };
+        std::string current;
+    public:
+        Dir() {}
+        Dir(const std::string& root, const std::string& prefix);
+        Dir(const Dir& o);
+        Dir& operator=(const Dir& o);
+        ~Dir();
+        bool next();
+        String fileName() const { return String(current.c_str()); }
+        size_t fileSize() const;
+        File openFile(const char* mode);
+        bool isFile() const { return true; }
+        bool isDirectory() const { return false; }
+    };
+
+    class FS {
+        std::string root;
+        size_t total;
+    public:
+        FS(const char* root, size_t total) : root(root), total(total) {}
+        bool begin();
+        void end() {}
+        bool setConfig(const FSConfig&) { return true; }
+        bool format();
+        bool info(FSInfo& info);
+        File open(const String& path, const char* mode);
+        File open(const char* path, const char* mode) { return open(String(path), mode); }
+        bool exists(const String& path);
+        bool exists(const char* path) { return exists(String(path)); }
+        bool remove(const String& path);
+        bool remove(const char* path) { return remove(String(path)); }
+        bool rename(const String& a, const String& b);
+        bool rename(const char* a, const char* b) { return rename(String(a), String(b)); }
+        Dir openDir(const String& path);
+        Dir openDir(const char* path) { return openDir(String(path)); }
+        const std::string& path() const { return root; }
+    };
+}
+
+using fs::File;
+using fs::Dir;
+using fs::FS;
+
+typedef fs::FSConfig SPIFFSConfig;
+typedef fs::FSConfig LittleFSConfig;
+
+extern FS SPIFFS;
+extern FS LittleFS;
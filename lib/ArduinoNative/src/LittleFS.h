@@ -0,0 +1,9 @@
+/*
+   This software is licensed under the MIT License. See the license file for details.
+   Source: https://github.com/spacehuhntech/WiFiDuck
+ */
+
+#pragma once
+
+// LittleFS is declared with SPIFFS in FS.h
+#include "FS.h"
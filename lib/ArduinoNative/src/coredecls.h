@@ -0,0 +1,11 @@
+/*
+   This software is licensed under the MIT License. See the license file for details.
+   Source: https://github.com/spacehuhntech/WiFiDuck
+ */
+
+#pragma once
+
+// The host has no SYS context, it can always yield
+inline bool can_yield() {
+    return true;
+}
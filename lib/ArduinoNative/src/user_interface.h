@@ -0,0 +1,16 @@
+/*
+   This software is licensed under the MIT License. See the license file for details.
+   Source: https://github.com/spacehuhntech/WiFiDuck
+ */
+
+#pragma once
+#include <stdint.h>
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+uint32_t system_get_free_heap_size(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -101,6 +101,7 @@ class AsyncWebSocketMessageBuffer {
     void unlock() { _lock = false; }
     uint8_t * get() { return _data; }
     size_t length() { return _len; }
+    void setLength(size_t len) { _len = len; } // At most the size the buffer was made with
     uint32_t count() { return _count; }
     bool canDelete() { return (!_count && !_lock); } 
 
@@ -10,6 +10,25 @@ extern "C" {
 #include "c/cmd.h"       // cmd
 #include "c/parser.h"    // parse_lines
 #include "c/cmd_error.h" // cmd_error_destroy
+#include "c/arena.h"     // arena_reset
+}
+
+#include <stdlib.h> // qsort
+
+namespace {
+    char lower(char c) {
+        return (c >= 'A' && c <= 'Z') ? (char)(c + 32) : c;
+    }
+
+    // Case insensitive, the command decides about the case when it's parsed
+    int compareKey(const char* a, size_t a_len, const char* b, size_t b_len) {
+        for (size_t i = 0; i < a_len && i < b_len; ++i) {
+            if (lower(a[i]) != lower(b[i])) return lower(a[i]) < lower(b[i]) ? -1 : 1;
+        }
+
+        if (a_len == b_len) return 0;
+        return a_len < b_len ? -1 : 1;
+    }
 }
 
 SimpleCLI::SimpleCLI(int commandQueueSize, int errorQueueSize) : commandQueueSize(commandQueueSize), errorQueueSize(errorQueueSize) {}
@@ -18,6 +37,115 @@ SimpleCLI::~SimpleCLI() {
     cmd_destroy_rec(cmdList);
     cmd_destroy_rec(cmdQueue);
     cmd_error_destroy_rec(errorQueue);
+
+    free(keys);
+    free(keyData);
+}
+
+// A name like "f/ile,g" can be typed as "f", "file" or "g"
+void SimpleCLI::buildIndex() {
+    free(keys);
+    free(keyData);
+
+    keys      = NULL;
+    keyData   = NULL;
+    keysSize  = 0;
+    keysValid = true;
+
+    // Count the spellings and their characters
+    size_t dataSize = 0;
+
+    for (cmd* h = cmdList; h; h = h->next) {
+        size_t len = 0;
+
+        for (const char* c = h->name; ; ++c) {
+            if ((*c == '/') || (*c == ',') || (*c == '\0')) {
+                ++keysSize;
+                dataSize += len;
+            }
+
+            if (*c == '\0') break;
+            if (*c == ',') len = 0;
+            else if (*c != '/') ++len;
+        }
+    }
+
+    keys    = (cmd_key*)malloc(keysSize * sizeof(cmd_key));
+    keyData = (char*)malloc(dataSize > 0 ? dataSize : 1);
+
+    if (!keys || !keyData) {
+        free(keys);
+        free(keyData);
+        keys      = NULL;
+        keyData   = NULL;
+        keysSize  = 0;
+        keysValid = false;
+        return;
+    }
+
+    int    k     = 0;
+    int    order = 0;
+    char * data  = keyData;
+
+    for (cmd* h = cmdList; h; h = h->next) {
+        const char* start = h->name; // Start of the alternative
+        size_t len        = 0;
+
+        for (const char* c = h->name; ; ++c) {
+            if ((*c == '/') || (*c == ',') || (*c == '\0')) {
+                // The alternative without slashes up to here
+                for (const char* s = start; s < c; ++s) {
+                    if (*s != '/') *data++ = *s;
+                }
+
+                keys[k].str     = data - len;
+                keys[k].len     = len;
+                keys[k].order   = order;
+                keys[k].command = h;
+                ++k;
+            }
+
+            if (*c == '\0') break;
+
+            if (*c == ',') {
+                start = c + 1;
+                len   = 0;
+            } else if (*c != '/') {
+                ++len;
+            }
+        }
+
+        ++order;
+    }
+
+    qsort(keys, keysSize, sizeof(cmd_key), sortKeys);
+}
+
+// First key that equals name, -1 when there is none
+// Alphabetical, the same spelling in the order the commands were added
+int SimpleCLI::sortKeys(const void* a, const void* b) {
+    const cmd_key* ka = (const cmd_key*)a;
+    const cmd_key* kb = (const cmd_key*)b;
+
+    int res = compareKey(ka->str, ka->len, kb->str, kb->len);
+
+    return res != 0 ? res : ka->order - kb->order;
+}
+
+int SimpleCLI::findKey(const char* name, size_t name_len) const {
+    int a = 0;
+    int b = keysSize;
+
+    while (a < b) {
+        int m = a + (b - a) / 2;
+
+        if (compareKey(keys[m].str, keys[m].len, name, name_len) < 0) a = m + 1;
+        else b = m;
+    }
+
+    if ((a < keysSize) && (compareKey(keys[a].str, keys[a].len, name, name_len) == 0)) return a;
+
+    return -1;
 }
 
 void SimpleCLI::parse(const String& input) {
@@ -32,11 +160,15 @@ void SimpleCLI::parse(const char* str, size_t len) {
     // Split str into a list of lines
     line_list* l = parse_lines(str, len);
 
-    // Go through all lines and try to find a matching command
+    if (!keysValid) buildIndex();
+
+    // Go through all lines and try the commands that have the first word as name
     line_node* n = l->first;
 
     while (n) {
-        cmd* h       = cmdList;
+        word_node* w = n->words->first;
+        int  k       = (keys && w) ? findKey(w->str, w->len) : -1;
+        cmd* h       = keys ? (k >= 0 ? keys[k].command : NULL) : cmdList;
         bool success = false;
         bool errored = false;
 
@@ -72,7 +204,21 @@ void SimpleCLI::parse(const char* str, size_t len) {
 
             cmd_reset(h);
 
-            h = h->next;
+            // Without an index (out of memory) every command is tried
+            if (!keys) {
+                h = h->next;
+                continue;
+            }
+
+            cmd* prev = h;
+            h = NULL;
+
+            while (++k < keysSize && compareKey(keys[k].str, keys[k].len, w->str, w->len) == 0) {
+                if (keys[k].command != prev) {
+                    h = keys[k].command;
+                    break;
+                }
+            }
         }
 
         // No error but no success either => Command could not be found
@@ -94,6 +240,9 @@ void SimpleCLI::parse(const char* str, size_t len) {
     }
 
     line_list_destroy(l);
+
+    // All nodes are gone, the arena can be reused by the next input
+    arena_reset(parser_get_arena());
 }
 
 bool SimpleCLI::available() const {
@@ -201,6 +350,8 @@ void SimpleCLI::addCmd(Command& c) {
 
     c.setCaseSensetive(caseSensetive);
     c.persistent = true;
+
+    keysValid = false;
 }
 
 Command SimpleCLI::addCmd(const char* name, void (* callback)(cmd* c)) {
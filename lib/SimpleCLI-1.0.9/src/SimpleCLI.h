@@ -27,6 +27,23 @@ class SimpleCLI {
 
         void (* onError)(cmd_error* e) = NULL;
 
+        // Every spelling of every command name, sorted, so parse()
+        // finds the commands of a line with a binary search
+        struct cmd_key {
+            const char* str;
+            size_t      len;
+            int         order; // Position in cmdList, earlier commands win
+            cmd       * command;
+        };
+
+        cmd_key* keys { NULL };
+        char   * keyData { NULL }; // The spellings, one after another
+        int keysSize { 0 };
+        bool keysValid { false };
+
+        static int sortKeys(const void* a, const void* b);
+        int findKey(const char* name, size_t name_len) const;
+
         cmd* getNextCmd(cmd* begin, const char* name, size_t name_len);
         void parseLine(const char* input, size_t input_len);
 
@@ -40,6 +57,8 @@ class SimpleCLI {
         void parse(const char* input);
         void parse(const char* input, size_t input_len);
 
+        void buildIndex();
+
         bool available() const;
         bool errored() const;
 
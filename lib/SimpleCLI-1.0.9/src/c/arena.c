@@ -0,0 +1,45 @@
+/*
+   Copyright (c) 2019 Stefan Kremser
+   This software is licensed under the MIT License. See the license file for details.
+   Source: github.com/spacehuhn/SimpleCLI
+ */
+
+#include "c/arena.h"
+
+#include <stdlib.h> // malloc
+
+// ===== Arena ===== //
+void* arena_alloc(arena* a, size_t size) {
+    size_t aligned = (size + ARENA_ALIGN - 1) & ~(ARENA_ALIGN - 1);
+
+    if (a && a->buf && (a->used + aligned <= a->size)) {
+        void* ptr = &a->buf[a->used];
+
+        a->used += aligned;
+        if (a->used > a->peak) a->peak = a->used;
+
+        return ptr;
+    }
+
+    // Arena is full, fall back to the heap
+    if (a) ++(a->overflows);
+
+    return malloc(size);
+}
+
+void arena_free(arena* a, void* ptr) {
+    // Memory of the arena is only given back by arena_reset
+    if (ptr && !arena_contains(a, ptr)) {
+        free(ptr);
+    }
+}
+
+void arena_reset(arena* a) {
+    if (a) {
+        a->used = 0;
+    }
+}
+
+int arena_contains(arena* a, void* ptr) {
+    return a && a->buf && ((uint8_t*)ptr >= a->buf) && ((uint8_t*)ptr < a->buf + a->size);
+}
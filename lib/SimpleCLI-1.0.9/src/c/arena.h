@@ -0,0 +1,21 @@
+/*
+   Copyright (c) 2019 Stefan Kremser
+   This software is licensed under the MIT License. See the license file for details.
+   Source: github.com/spacehuhn/SimpleCLI
+ */
+
+#ifndef arena_h
+#define arena_h
+
+#include "c/arena_types.h"
+
+#define ARENA_ALIGN sizeof(void*)
+
+// ===== Arena ===== //
+void* arena_alloc(arena* a, size_t size);
+void arena_free(arena* a, void* ptr);
+void arena_reset(arena* a);
+
+int arena_contains(arena* a, void* ptr);
+
+#endif /* ifndef arena_h */
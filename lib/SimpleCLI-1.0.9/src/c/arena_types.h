@@ -0,0 +1,21 @@
+/*
+   Copyright (c) 2019 Stefan Kremser
+   This software is licensed under the MIT License. See the license file for details.
+   Source: github.com/spacehuhn/SimpleCLI
+ */
+
+#ifndef arena_types_h
+#define arena_types_h
+
+#include <stddef.h> // size_t
+#include <stdint.h> // uint8_t
+
+typedef struct arena {
+    uint8_t* buf;       // Fixed memory block
+    size_t   size;      // Size of buf
+    size_t   used;      // Bytes handed out since the last reset
+    size_t   peak;      // Highest value of used
+    size_t   overflows; // Allocations that didn't fit and went to the heap
+} arena;
+
+#endif /* ifndef arena_types_h */
@@ -6,11 +6,19 @@
 
 #include "c/parser.h"
 
-#include <stdlib.h> // malloc
+#include "c/arena.h" // arena_alloc
+
+// ===== Arena ===== //
+static void* parser_arena_buf[PARSER_ARENA_SIZE / sizeof(void*)];
+static arena parser_arena = { (uint8_t*)parser_arena_buf, sizeof(parser_arena_buf), 0, 0, 0 };
+
+arena* parser_get_arena() {
+    return &parser_arena;
+}
 
 // ===== Word Node ===== //
 word_node* word_node_create(const char* str, size_t len) {
-    word_node* n = (word_node*)malloc(sizeof(word_node));
+    word_node* n = (word_node*)arena_alloc(&parser_arena, sizeof(word_node));
 
     n->str  = str;
     n->len  = len;
@@ -20,7 +28,7 @@ word_node* word_node_create(const char* str, size_t len) {
 
 word_node* word_node_destroy(word_node* n) {
     if (n) {
-        free(n);
+        arena_free(&parser_arena, n);
     }
     return NULL;
 }
@@ -35,7 +43,7 @@ word_node* word_node_destroy_rec(word_node* n) {
 
 // ===== Word List ===== //
 word_list* word_list_create() {
-    word_list* l = (word_list*)malloc(sizeof(word_list));
+    word_list* l = (word_list*)arena_alloc(&parser_arena, sizeof(word_list));
 
     l->first = NULL;
     l->last  = NULL;
@@ -46,7 +54,7 @@ word_list* word_list_create() {
 word_list* word_list_destroy(word_list* l) {
     if (l) {
         word_node_destroy_rec(l->first);
-        free(l);
+        arena_free(&parser_arena, l);
     }
     return NULL;
 }
@@ -79,7 +87,7 @@ word_node* word_list_get(word_list* l, size_t i) {
 
 // ===== Line Node ==== //
 line_node* line_node_create(const char* str, size_t len) {
-    line_node* n = (line_node*)malloc(sizeof(line_node));
+    line_node* n = (line_node*)arena_alloc(&parser_arena, sizeof(line_node));
 
     n->str   = str;
     n->len   = len;
@@ -92,7 +100,7 @@ line_node* line_node_create(const char* str, size_t len) {
 word_node* line_node_destroy(line_node* n) {
     if (n) {
         word_list_destroy(n->words);
-        free(n);
+        arena_free(&parser_arena, n);
     }
     return NULL;
 }
@@ -107,7 +115,7 @@ word_node* line_node_destroy_rec(line_node* n) {
 
 // ===== Line List ===== //
 line_list* line_list_create() {
-    line_list* l = (line_list*)malloc(sizeof(line_list));
+    line_list* l = (line_list*)arena_alloc(&parser_arena, sizeof(line_list));
 
     l->first = NULL;
     l->last  = NULL;
@@ -119,7 +127,7 @@ line_list* line_list_create() {
 line_list* line_list_destroy(line_list* l) {
     if (l) {
         line_node_destroy_rec(l->first);
-        free(l);
+        arena_free(&parser_arena, l);
     }
     return NULL;
 }
@@ -8,6 +8,14 @@
 #define parser_h
 
 #include "c/parser_types.h"
+#include "c/arena_types.h"
+
+#ifndef PARSER_ARENA_SIZE
+#define PARSER_ARENA_SIZE 256
+#endif /* ifndef PARSER_ARENA_SIZE */
+
+// ===== Arena ===== //
+arena* parser_get_arena();
 
 // ===== Word Node ===== //
 word_node* word_node_create(const char* str, size_t len);
@@ -0,0 +1,124 @@
+#!/usr/bin/env python3
+"""
+   This software is licensed under the MIT License. See the license file for details.
+   Source: https://github.com/spacehuhntech/WiFiDuck
+
+   Compresses a ducky script into a .duckz file that takes less space on
+   the flash and can be run like the plain script. It's decompressed while
+   it's read, with a window of 2^WINDOW_BITS bytes of RAM.
+
+   The data is in the format of heatshrink, the format of the file is
+   described in include/lzss.h.
+
+   Usage: python3 scripts/compress.py [-w WINDOW_BITS] [-l LOOKAHEAD_BITS] SCRIPT [OUT]
+"""
+
+import argparse
+import os
+import struct
+
+# Must match include/lzss.h
+DUCKZ_EXTENSION = ".duckz"
+DUCKZ_MAGIC = b"DUKZ"
+DUCKZ_VERSION = 1
+
+# Must match LZSS_MAX_WINDOW_BITS in include/config.h
+MAX_WINDOW_BITS = 10
+
+
+class BitWriter:
+    def __init__(self):
+        self.data = bytearray()
+        self.byte = 0
+        self.bits = 0
+
+    def write(self, value, count):
+        for i in reversed(range(count)):
+            self.byte = (self.byte << 1) | ((value >> i) & 1)
+            self.bits += 1
+
+            if self.bits == 8:
+                self.data.append(self.byte)
+                self.byte = 0
+                self.bits = 0
+
+    def finish(self):
+        if self.bits > 0:
+            self.data.append(self.byte << (8 - self.bits))
+        return bytes(self.data)
+
+
+def compress(data, window_bits, lookahead_bits):
+    window = 1 << window_bits
+    lookahead = 1 << lookahead_bits
+
+    # A match is only worth it when it's shorter than its bytes as literals
+    min_len = (1 + window_bits + lookahead_bits) // 9 + 1
+
+    # Positions of every 2 byte sequence, to find matches quickly
+    positions = {}
+    out = BitWriter()
+    i = 0
+
+    while i < len(data):
+        best_len = 0
+        best_from = 0
+
+        for j in reversed(positions.get(data[i:i + 2], [])):
+            if i - j > window:
+                break
+
+            n = 0
+            while n < lookahead and i + n < len(data) and data[j + n] == data[i + n]:
+                n += 1
+
+            if n > best_len:
+                best_len = n
+                best_from = i - j
+
+                if n == lookahead:
+                    break
+
+        if best_len >= min_len:
+            out.write(0, 1)
+            out.write(best_from - 1, window_bits)
+            out.write(best_len - 1, lookahead_bits)
+        else:
+            best_len = 1
+            out.write(1, 1)
+            out.write(data[i], 8)
+
+        for k in range(i, i + best_len):
+            positions.setdefault(data[k:k + 2], []).append(k)
+
+        i += best_len
+
+    return out.finish()
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compresses a ducky script into a .duckz file")
+    parser.add_argument("-w", dest="window_bits", type=int, default=8, help="window size in bits (4-%d)" % MAX_WINDOW_BITS)
+    parser.add_argument("-l", dest="lookahead_bits", type=int, default=4, help="longest match in bits")
+    parser.add_argument("script")
+    parser.add_argument("out", nargs="?")
+    args = parser.parse_args()
+
+    assert 4 <= args.window_bits <= MAX_WINDOW_BITS, "window bits must be between 4 and %d" % MAX_WINDOW_BITS
+    assert 3 <= args.lookahead_bits < args.window_bits, "lookahead bits must be between 3 and the window bits"
+
+    with open(args.script, "rb") as f:
+        data = f.read()
+
+    out = args.out or os.path.splitext(args.script)[0] + DUCKZ_EXTENSION
+    header = struct.pack("<4sBBBxI", DUCKZ_MAGIC, DUCKZ_VERSION, args.window_bits, args.lookahead_bits, len(data))
+    compressed = compress(data, args.window_bits, args.lookahead_bits)
+
+    with open(out, "wb") as f:
+        f.write(header + compressed)
+
+    print("Wrote %s (%d bytes, %d%% of %d)" % (out, len(header) + len(compressed), 100 * (len(header) + len(compressed)) // max(len(data), 1), len(data)))
+
+
+if __name__ == "__main__":
+    main()
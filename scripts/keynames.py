@@ -0,0 +1,194 @@
+#!/usr/bin/env python3
+"""
+   This software is licensed under the MIT License. See the license file for details.
+   Source: https://github.com/spacehuhntech/WiFiDuck
+
+   Generates include/keynames.h, a perfect hash table of all key names
+   that can be pressed in a ducky script.
+
+   Usage: python3 scripts/keynames.py
+"""
+
+import os
+import re
+
+ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..")
+KEYS_FILE = os.path.join(ROOT, "include", "usb_hid_keys.h")
+OUT_FILE = os.path.join(ROOT, "include", "keynames.h")
+
+# Ducky script names, they win over the names in usb_hid_keys.h
+# Add new aliases here, they don't make the lookup any slower
+ALIASES = [
+    # name          key                 modifier
+    ("ENTER",       "KEY_ENTER",        None),
+    ("MENU",        "KEY_PROPS",        None),
+    ("APP",         "KEY_PROPS",        None),
+    ("DELETE",      "KEY_BACKSPACE",    None),
+    ("HOME",        "KEY_HOME",         None),
+    ("INSERT",      "KEY_INSERT",       None),
+    ("PAGEUP",      "KEY_PAGEUP",       None),
+    ("PAGEDOWN",    "KEY_PAGEDOWN",     None),
+    ("UPARROW",     "KEY_UP",           None),
+    ("UP",          "KEY_UP",           None),
+    ("DOWNARROW",   "KEY_DOWN",         None),
+    ("DOWN",        "KEY_DOWN",         None),
+    ("LEFTARROW",   "KEY_LEFT",         None),
+    ("LEFT",        "KEY_LEFT",         None),
+    ("RIGHTARROW",  "KEY_RIGHT",        None),
+    ("RIGHT",       "KEY_RIGHT",        None),
+    ("TAB",         "KEY_TAB",          None),
+    ("END",         "KEY_END",          None),
+    ("ESC",         "KEY_ESC",          None),
+    ("ESCAPE",      "KEY_ESC",          None),
+    ("SPACE",       "KEY_SPACE",        None),
+    ("PAUSE",       "KEY_PAUSE",        None),
+    ("BREAK",       "KEY_PAUSE",        None),
+    ("CAPSLOCK",    "KEY_CAPSLOCK",     None),
+    ("NUMLOCK",     "KEY_NUMLOCK",      None),
+    ("PRINTSCREEN", "KEY_SYSRQ",        None),
+    ("SCROLLLOCK",  "KEY_SCROLLLOCK",   None),
+
+    ("CTRL",        None,               "KEY_MOD_LCTRL"),
+    ("CONTROL",     None,               "KEY_MOD_LCTRL"),
+    ("SHIFT",       None,               "KEY_MOD_LSHIFT"),
+    ("ALT",         None,               "KEY_MOD_LALT"),
+    ("WINDOWS",     None,               "KEY_MOD_LMETA"),
+    ("GUI",         None,               "KEY_MOD_LMETA"),
+]
+
+# Not pressable by name
+IGNORE = ["KEY_NONE", "KEY_ERR_OVF"]
+
+
+def fnv1a(name, seed):
+    h = (2166136261 ^ seed) & 0xFFFFFFFF
+    for c in name.upper().encode():
+        h ^= c
+        h = (h * 16777619) & 0xFFFFFFFF
+    return h
+
+
+def read_keys():
+    keys = []
+    with open(KEYS_FILE) as f:
+        for line in f:
+            m = re.match(r"#define\s+(KEY_\w+)\s+(0x[0-9a-fA-F]+)", line)
+            if m and m.group(1) not in IGNORE:
+                keys.append((m.group(1), int(m.group(2), 16)))
+    return keys
+
+
+def make_entries():
+    keys = read_keys()
+    values = dict(keys)
+    entries = {}
+
+    for name, key, mod in ALIASES:
+        entries[name] = (key or "KEY_NONE", mod or "KEY_NONE")
+
+    for define, value in keys:
+        name = define[len("KEY_"):]
+
+        # Single characters are typed with the current locale
+        if len(name) == 1 or name in entries:
+            continue
+
+        if define.startswith("KEY_MOD_"):
+            entries[name] = ("KEY_NONE", define)
+        else:
+            entries[name] = (define, "KEY_NONE")
+
+    for name, (key, mod) in entries.items():
+        assert key == "KEY_NONE" or key in values, key
+        assert mod == "KEY_NONE" or mod in values, mod
+
+    return list(entries.items())
+
+
+def perfect_hash(names):
+    n = len(names)
+    buckets = [[] for _ in range((n + 2) // 3)]
+
+    for name in names:
+        buckets[fnv1a(name, 0) % len(buckets)].append(name)
+
+    slots = [None] * n
+    seeds = [0] * len(buckets)
+
+    # Place the biggest buckets first, search a seed that puts all names of a bucket into free slots
+    for b in sorted(range(len(buckets)), key=lambda b: -len(buckets[b])):
+        if not buckets[b]:
+            continue
+
+        for seed in range(1, 0x10000):
+            pos = [fnv1a(name, seed) % n for name in buckets[b]]
+
+            if len(set(pos)) == len(pos) and all(slots[p] is None for p in pos):
+                for p, name in zip(pos, buckets[b]):
+                    slots[p] = name
+                seeds[b] = seed
+                break
+        else:
+            raise RuntimeError("No seed found for bucket %d" % b)
+
+    return seeds, slots
+
+
+def main():
+    entries = dict(make_entries())
+    seeds, slots = perfect_hash(list(entries.keys()))
+
+    pool = ""
+    lines = []
+
+    for name in slots:
+        key, mod = entries[name]
+        lines.append("    { %4d, %2d, %-22s %-15s }, // %s" % (len(pool), len(name), key + ",", mod, name))
+        pool += name
+
+    out = []
+    out.append("/*")
+    out.append("   This software is licensed under the MIT License. See the license file for details.")
+    out.append("   Source: https://github.com/spacehuhntech/WiFiDuck")
+    out.append(" */")
+    out.append("")
+    out.append("// Generated by scripts/keynames.py, do not edit!")
+    out.append("")
+    out.append("#pragma once")
+    out.append("")
+    out.append("#include \"usb_hid_keys.h\"")
+    out.append("")
+    out.append("#define KEYNAMES_LEN %d" % len(slots))
+    out.append("#define KEYNAMES_BUCKETS %d" % len(seeds))
+    out.append("")
+    out.append("typedef struct keyname_t {")
+    out.append("    uint16_t name;     // Offset in keynames_pool")
+    out.append("    uint8_t  name_len;")
+    out.append("    uint8_t  key;")
+    out.append("    uint8_t  modifiers;")
+    out.append("} keyname_t;")
+    out.append("")
+    out.append("// Seed of the second hash for every bucket of the first hash")
+    out.append("const uint16_t keynames_seeds[] PROGMEM = {")
+    for i in range(0, len(seeds), 12):
+        out.append("    " + " ".join("%5d," % s for s in seeds[i:i + 12]))
+    out.append("};")
+    out.append("")
+    out.append("const char keynames_pool[] PROGMEM =")
+    for i in range(0, len(pool), 80):
+        out.append("    \"%s\"" % pool[i:i + 80])
+    out.append(";")
+    out.append("")
+    out.append("const keyname_t keynames[] PROGMEM = {")
+    out.extend(lines)
+    out.append("};")
+    out.append("")
+
+    with open(OUT_FILE, "w") as f:
+        f.write("\n".join(out))
+
+    print("Wrote %d key names to %s" % (len(slots), OUT_FILE))
+
+
+if __name__ == "__main__":
+    main()
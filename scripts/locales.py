@@ -0,0 +1,267 @@
+#!/usr/bin/env python3
+"""
+   This software is licensed under the MIT License. See the license file for details.
+   Source: https://github.com/spacehuhntech/WiFiDuck
+
+   Generates include/locales/locales.h and src/locales.cpp from the
+   keyboard layouts in scripts/layouts.txt.
+
+   Every character is packed into one byte, the index of its key in the
+   shared key alphabet locale_keys and the modifiers in the two high bits.
+   The utf8 and extended ascii tables are sorted for a binary search and
+   store the packed byte next to the code, so an entry is a single word.
+
+   With --bin, every layout is written to DIR/NAME.layout instead, a file
+   that can be uploaded and used with LOCALE NAME without flashing again.
+   The format is described in include/layouts.h.
+
+   Usage: python3 scripts/locales.py [--bin DIR [LAYOUTS_FILE]]
+"""
+
+import os
+import re
+import struct
+import sys
+
+ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..")
+KEYS_FILE = os.path.join(ROOT, "include", "usb_hid_keys.h")
+LAYOUTS_FILE = os.path.join(ROOT, "scripts", "layouts.txt")
+HEADER_FILE = os.path.join(ROOT, "include", "locales", "locales.h")
+SOURCE_FILE = os.path.join(ROOT, "src", "locales.cpp")
+
+# Must match include/locales/locale_types.h
+KEY_BITS = 6
+MODIFIERS = {
+    "-":           0x00,
+    "SHIFT":       0x40, # LOCALE_SHIFT
+    "ALTGR":       0x80, # LOCALE_ALTGR
+    "ALTGR+SHIFT": 0xC0,
+}
+
+# Must match include/layouts.h
+LAYOUT_EXTENSION = ".layout"
+LAYOUT_MAGIC = b"LAYT"
+LAYOUT_VERSION = 1
+LAYOUT_NAME_LEN = 16
+
+LICENSE = [
+    "/*",
+    "   This software is licensed under the MIT License. See the license file for details.",
+    "   Source: https://github.com/spacehuhntech/WiFiDuck",
+    " */",
+    "",
+    "// Generated by scripts/locales.py from scripts/layouts.txt, do not edit!",
+    "",
+]
+
+
+def read_keys():
+    keys = {}
+    with open(KEYS_FILE) as f:
+        for line in f:
+            m = re.match(r"#define\s+(KEY_\w+)\s+(0x[0-9a-fA-F]+)", line)
+            if m:
+                keys[m.group(1)] = int(m.group(2), 16)
+    return keys
+
+
+def parse_char(token, where):
+    m = re.fullmatch(r"\\x([0-9a-fA-F]{2})", token)
+
+    if m:
+        return int(m.group(1), 16), False
+
+    assert len(token) == 1, "%s: %s is not a single character" % (where, token)
+
+    return ord(token), ord(token) >= 0x80
+
+
+def read_layouts(keys, file):
+    layouts = []
+
+    with open(file, encoding="utf-8") as f:
+        for n, line in enumerate(f, 1):
+            where = "%s:%d" % (os.path.basename(file), n)
+            line = line.rstrip("\n")
+
+            if line.startswith("//"):
+                continue
+
+            line, _, comment = line.partition(" //")
+            tokens = line.split()
+
+            if not tokens:
+                continue
+
+            m = re.fullmatch(r"\[(\w+)\]", tokens[0])
+
+            if m:
+                layouts.append({"name": m.group(1).upper(), "ascii": {}, "extended_ascii": {}, "utf8": {}})
+                continue
+
+            assert layouts, "%s: character outside of a layout" % where
+            assert len(tokens) == 3, "%s: expected character, modifiers and key" % where
+
+            char, mods, key = tokens
+            code, utf8 = parse_char(char, where)
+
+            assert mods in MODIFIERS, "%s: unknown modifiers %s" % (where, mods)
+            assert "KEY_" + key in keys, "%s: unknown key %s" % (where, key)
+
+            table = "utf8" if utf8 else ("extended_ascii" if code >= 0x80 else "ascii")
+            layout = layouts[-1]
+
+            assert code not in layout[table], "%s: %s is defined twice" % (where, char)
+            layout[table][code] = (mods, "KEY_" + key, comment.strip() or (char if utf8 else ""))
+
+    return layouts
+
+
+def describe(code):
+    return chr(code) if 0x20 < code < 0x7F else ""
+
+
+def make_alphabet(keys, layouts):
+    # Shared key alphabet, KEY_NONE first so a zero byte is an empty entry
+    used = set(key for layout in layouts for table in ("ascii", "extended_ascii", "utf8") for mods, key, comment in layout[table].values())
+    alphabet = ["KEY_NONE"] + sorted(used - {"KEY_NONE"}, key=lambda k: keys[k])
+
+    assert len(alphabet) <= (1 << KEY_BITS), "%d keys don't fit in %d bits" % (len(alphabet), KEY_BITS)
+
+    return alphabet
+
+
+def write_binaries(keys, layouts, out_dir):
+    os.makedirs(out_dir, exist_ok=True)
+
+    for layout in layouts:
+        assert len(layout["name"]) <= LAYOUT_NAME_LEN, "%s: name is too long" % layout["name"]
+
+        alphabet = make_alphabet(keys, [layout])
+
+        def pack(entry):
+            mods, key, comment = entry
+            return MODIFIERS[mods] | alphabet.index(key)
+
+        ascii_table = [pack(layout["ascii"][c]) if c in layout["ascii"] else 0 for c in range(128)]
+        extended_ascii = sorted(layout["extended_ascii"].items())
+        utf8 = sorted(layout["utf8"].items())
+
+        data = struct.pack("<4sBBHH2x", LAYOUT_MAGIC, LAYOUT_VERSION, len(alphabet), len(extended_ascii), len(utf8))
+        data += bytes(keys[k] for k in alphabet)
+        data += bytes(ascii_table)
+        data += b"".join(struct.pack("<H", (pack(entry) << 8) | code) for code, entry in extended_ascii)
+        data += b"".join(struct.pack("<I", (pack(entry) << 24) | code) for code, entry in utf8)
+
+        file = os.path.join(out_dir, layout["name"] + LAYOUT_EXTENSION)
+
+        with open(file, "wb") as f:
+            f.write(data)
+
+        print("Wrote %s (%d bytes)" % (file, len(data)))
+
+
+def main():
+    keys = read_keys()
+
+    if len(sys.argv) > 2 and sys.argv[1] == "--bin":
+        layouts = read_layouts(keys, sys.argv[3] if len(sys.argv) > 3 else LAYOUTS_FILE)
+        write_binaries(keys, layouts, sys.argv[2])
+        return
+
+    layouts = read_layouts(keys, LAYOUTS_FILE)
+    alphabet = make_alphabet(keys, layouts)
+
+    def pack(entry):
+        mods, key, comment = entry
+        return MODIFIERS[mods] | alphabet.index(key)
+
+    # Header
+    out = list(LICENSE)
+    out.append("#pragma once")
+    out.append("")
+    out.append("#include \"usb_hid_keys.h\"")
+    out.append("#include \"locale_types.h\"")
+    out.append("")
+    out.append("#define LOCALE_KEYS_LEN %d" % len(alphabet))
+    out.append("#define LOCALES_LEN %d" % len(layouts))
+    out.append("")
+    out.append("// Key of every index of a packed character")
+    out.append("extern const uint8_t locale_keys[LOCALE_KEYS_LEN];")
+    out.append("")
+    for layout in layouts:
+        out.append("extern hid_locale_t locale_%s;" % layout["name"].lower())
+    out.append("")
+    out.append("extern hid_locale_t* const locales[LOCALES_LEN];")
+    out.append("")
+
+    with open(HEADER_FILE, "w") as f:
+        f.write("\n".join(out))
+
+    # Source
+    out = list(LICENSE)
+    out.append("#include \"locales/locales.h\"")
+    out.append("")
+    out.append("// Kept in RAM, it's read for every character")
+    out.append("const uint8_t locale_keys[LOCALE_KEYS_LEN] = {")
+    for i in range(0, len(alphabet), 4):
+        out.append("    " + " ".join("%-17s" % (k + ",") for k in alphabet[i:i + 4]).rstrip())
+    out.append("};")
+
+    for layout in layouts:
+        name = layout["name"].lower()
+
+        out.append("")
+        out.append("// ===== %s ===== //" % layout["name"])
+        out.append("const uint8_t ascii_%s[128] PROGMEM = {" % name)
+        for i in range(0, 128, 8):
+            row = [pack(layout["ascii"][c]) if c in layout["ascii"] else 0 for c in range(i, i + 8)]
+            chars = " ".join(describe(c) for c in range(i, i + 8) if describe(c))
+            out.append(("    %s // 0x%02X %s" % (" ".join("0x%02X," % b for b in row), i, chars)).rstrip())
+        out.append("};")
+
+        if layout["extended_ascii"]:
+            out.append("")
+            out.append("// Packed character << 8 | code")
+            out.append("const uint16_t extended_ascii_%s[] PROGMEM = {" % name)
+            for code, entry in sorted(layout["extended_ascii"].items()):
+                out.append(("    0x%02X%02X, // %s" % (pack(entry), code, entry[2])).rstrip())
+            out.append("};")
+
+        if layout["utf8"]:
+            out.append("")
+            out.append("// Packed character << 24 | codepoint")
+            out.append("const uint32_t utf8_%s[] PROGMEM = {" % name)
+            for code, entry in sorted(layout["utf8"].items()):
+                out.append(("    0x%02X%06X, // %s" % (pack(entry), code, entry[2])).rstrip())
+            out.append("};")
+
+        out.append("")
+        out.append("hid_locale_t locale_%s {" % name)
+        out.append("    \"%s\"," % layout["name"])
+        out.append("    locale_keys,")
+        out.append("    ascii_%s, 128," % name)
+        if layout["extended_ascii"]:
+            out.append("    extended_ascii_%s, sizeof(extended_ascii_%s) / sizeof(uint16_t)," % (name, name))
+        else:
+            out.append("    NULL, 0,")
+        if layout["utf8"]:
+            out.append("    utf8_%s, sizeof(utf8_%s) / sizeof(uint32_t)" % (name, name))
+        else:
+            out.append("    NULL, 0")
+        out.append("};")
+
+    out.append("")
+    out.append("hid_locale_t* const locales[LOCALES_LEN] {")
+    out.append("    " + ", ".join("&locale_%s" % layout["name"].lower() for layout in layouts))
+    out.append("};")
+    out.append("")
+
+    with open(SOURCE_FILE, "w") as f:
+        f.write("\n".join(out))
+
+    print("Wrote %d layouts with %d keys to %s and %s" % (len(layouts), len(alphabet), HEADER_FILE, SOURCE_FILE))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,239 @@
+/*
+   This software is licensed under the MIT License. See the license file for details.
+   Source: https://github.com/spacehuhntech/WiFiDuck
+ */
+
+#include "benchmark.h"
+
+// Get RAM (heap) usage
+extern "C" {
+#include "user_interface.h"
+}
+
+#include "config.h"
+#include "debug.h"
+
+#include "duckparser.h"
+#include "duckscript.h"
+#include "keyboard.h"
+#include "spiffs.h"
+#include "tracer.h"
+#include "webserver.h"
+
+#define BENCH_PARSER_RUNS 50    // Times the script is compiled
+#define BENCH_KEYBOARD_RUNS 20  // Times the text is typed into the null sink
+#define BENCH_UART_REPORTS 64   // Reports that are sent to the CH9328
+#define BENCH_PING_TIMEOUT 1000 // Longest time a ping is waited for (ms)
+
+namespace benchmark {
+    // ===== PRIVATE ===== //
+    // The commands that are used the most
+    const char script[] =
+        "REM Benchmark\n"
+        "DEFAULTDELAY 10\n"
+        "DELAY 500\n"
+        "GUI r\n"
+        "STRING notepad\n"
+        "ENTER\n"
+        "STRING The quick brown fox jumps over the lazy dog\n"
+        "CTRL ALT DELETE\n"
+        "SHIFT TAB\n"
+        "REPEAT 3\n";
+
+    const char text[] = "The quick brown fox jumps over the lazy dog 0123456789";
+
+    // Everything is measured before it's written, because measuring
+    // yields and the output is shared with the web socket callbacks
+    typedef struct result_t {
+        bool            busy; // A script or trace is running
+        uint32_t        parserRate;
+        uint32_t        parserTime;
+        uint32_t        nullRate;
+        uint32_t        uartRate;
+        spiffs::bench_t fs;
+        bool            answered; // The ping was answered
+        uint32_t        rtt;
+    } result_t;
+
+    result_t result;
+
+    bool     requested { false };
+    uint32_t client { 0 }; // Web socket client that requested it, 0 for the debug output
+
+    Print* out { nullptr };
+    bool   first { true }; // Nothing was written into the current object yet
+
+    void key(const char* name) {
+        if (!first) out->print(',');
+        first = false;
+
+        out->print('"');
+        out->print(name);
+        out->print("\":");
+    }
+
+    void value(const char* name, uint32_t v) {
+        key(name);
+        out->print(v);
+    }
+
+    void null(const char* name) {
+        key(name);
+        out->print("null");
+    }
+
+    void value(const char* name, const char* s) {
+        key(name);
+        out->print('"');
+        out->print(s);
+        out->print('"');
+    }
+
+    void beginObject(const char* name) {
+        if (name) key(name);
+        out->print('{');
+        first = true;
+    }
+
+    void endObject() {
+        out->print('}');
+        first = false;
+    }
+
+    uint32_t perSecond(uint32_t count, uint32_t time) {
+        return (uint64_t)count * 1000000 / _max(time, 1U);
+    }
+
+    void emitNothing(uint8_t code, const uint8_t* data, size_t len) {}
+
+    // Compiles the script without running it
+    void measureParser() {
+        uint32_t lines = 0;
+
+        for (size_t i = 0; i < sizeof(script) - 1; ++i) {
+            if (script[i] == '\n') ++lines;
+        }
+
+        lines *= BENCH_PARSER_RUNS;
+
+        uint32_t t = micros();
+
+        for (size_t i = 0; i < BENCH_PARSER_RUNS; ++i) {
+            duckparser::compile(script, sizeof(script) - 1, emitNothing);
+        }
+
+        t = micros() - t;
+
+        result.parserRate = perSecond(lines, t);
+        result.parserTime = t / lines;
+    }
+
+    // Types into a sink that drops the reports, then sends released reports
+    // to the CH9328, so the UART is measured without typing anything
+    void measureKeyboard() {
+        keyboard::flush();
+        keyboard::setDiscard(true);
+        keyboard::resetStats();
+
+        uint32_t t = micros();
+
+        for (size_t i = 0; i < BENCH_KEYBOARD_RUNS; ++i) keyboard::write(text, sizeof(text) - 1);
+
+        t = micros() - t;
+
+        result.nullRate = perSecond(keyboard::getSent(), t);
+
+        keyboard::setDiscard(false);
+        keyboard::resetStats();
+
+        t = micros();
+
+        for (size_t i = 0; i < BENCH_UART_REPORTS; ++i) keyboard::release();
+        keyboard::flush();
+
+        t = micros() - t;
+
+        result.uartRate = perSecond(keyboard::getSent(), t);
+    }
+
+    // Round trip of a ping to the client that requested the benchmark
+    void measureWs() {
+        result.answered = false;
+
+        if (!webserver::ping(client)) return;
+
+        uint32_t t = millis();
+
+        while (webserver::pinging() && (millis() - t < BENCH_PING_TIMEOUT)) delay(1);
+
+        result.answered = !webserver::pinging();
+        result.rtt      = webserver::getRoundTrip();
+    }
+
+    void write(Print& out) {
+        benchmark::out = &out;
+
+        beginObject(NULL);
+
+        if (result.busy) {
+            value("error", "can't measure while a script is running");
+        } else {
+            value("version", VERSION);
+            value("chip_id", system_get_chip_id());
+            value("cpu_mhz", system_get_cpu_freq());
+            value("heap", system_get_free_heap_size());
+
+            beginObject("parser");
+            value("lines_per_s", result.parserRate);
+            value("us_per_line", result.parserTime);
+            endObject();
+
+            beginObject("keyboard");
+            value("null_reports_per_s", result.nullRate);
+            value("uart_reports_per_s", result.uartRate);
+            endObject();
+
+            beginObject("fs");
+            value("name", spiffs::name());
+            value("open_us", result.fs.open);
+            value("pooled_open_us", result.fs.pooled);
+            value("read_kb_per_s", result.fs.read);
+            value("write_kb_per_s", result.fs.write);
+            value("ls_us", result.fs.list);
+            value("ls_cached_us", result.fs.cached);
+            value("files", result.fs.files);
+            endObject();
+
+            beginObject("ws");
+            if (result.answered) value("rtt_us", result.rtt);
+            else null("rtt_us");
+            endObject();
+        }
+
+        endObject();
+
+        benchmark::out = nullptr;
+    }
+
+    // ===== PUBLIC ===== //
+    void request() {
+        requested = true;
+        client    = webserver::currentClientId();
+    }
+
+    void update() {
+        if (!requested) return;
+
+        requested   = false;
+        result.busy = duckscript::isRunning() || tracer::replaying();
+
+        if (!result.busy) {
+            measureParser();
+            measureKeyboard();
+            spiffs::benchmark(result.fs);
+            measureWs();
+        }
+
+        webserver::print(client, write);
+    }
+}
@@ -15,9 +15,23 @@ extern "C" {
 #include "user_interface.h"
 }
 
+// Parser memory arenas
+extern "C" {
+#include "c/parser.h"
+}
+
 // Import modules used for different commands
 #include "spiffs.h"
 #include "duckscript.h"
+#include "duckcompiler.h"
+#include "duckparser.h"
+#include "keyboard.h"
+#include "layouts.h"
+#include "tracer.h"
+#include "reader.h"
+#include "benchmark.h"
+#include "upload.h"
+#include "webserver.h"
 #include "settings.h"
 #include "config.h"
 
@@ -25,19 +39,134 @@ namespace cli {
     // ===== PRIVATE ===== //
     SimpleCLI cli;           // !< Instance of SimpleCLI library
 
-    PrintFunction printfunc; // !< Function used to print output
+    Print* output { nullptr }; // !< Where output is written to
 
     /*!
      * \brief Internal print function
      *
-     * Outputs a c-string using the currently set printfunc.
+     * Outputs a string as one message to the current output.
      * Helps to keep code readable.
      * It's only defined in the scope of this file!
      *
      * \param s String to printed
      */
     inline void print(const String& s) {
-        if (printfunc) printfunc(s.c_str());
+        output->print(s);
+        output->flush();
+    }
+
+    /*!
+     * \brief Describes the usage of a memory arena
+     *
+     * \param name Name of the arena
+     * \param a    Pointer to the arena
+     *
+     * \return '<name>: <peak>/<size> byte peak, <overflows> overflows'
+     */
+    String arenaToString(const char* name, const arena* a) {
+        String s = name;
+
+        s += ": ";
+        s += String(a->peak);
+        s += "/";
+        s += String(a->size);
+        s += " byte peak, ";
+        s += String(a->overflows);
+        s += " overflows";
+
+        return s;
+    }
+
+    /*!
+     * \brief Output of a batch
+     *
+     * Passes everything on to the output of the batch without flushing it,
+     * the end of a message only starts a new line.
+     */
+    class BatchPrint : public Print {
+        public:
+            Print* out { nullptr }; // !< Output of the whole batch
+            char   last { '\n' };   // !< Last character that was written
+
+            size_t write(uint8_t c) override {
+                last = c;
+                return out->write(c);
+            }
+
+            size_t write(const uint8_t* buf, size_t len) override {
+                if (len > 0) last = buf[len - 1];
+                return out->write(buf, len);
+            }
+
+            void flush() override {
+                if (last != '\n') write('\n');
+            }
+    };
+
+    /*!
+     * \brief Finds the end of a command
+     *
+     * Commands are separated by line breaks or ";;",
+     * the same as SimpleCLI does, but not inside of quotes.
+     *
+     * \param s Start of the command
+     *
+     * \return Pointer to the separator or the end of the string
+     */
+    const char* commandEnd(const char* s) {
+        bool quoted = false;
+
+        for (; *s; ++s) {
+            if (*s == '"') quoted = !quoted;
+            if (quoted) continue;
+            if ((*s == '\n') || (*s == '\r') || ((s[0] == ';') && (s[1] == ';'))) break;
+        }
+
+        return s;
+    }
+
+    /*!
+     * \brief Runs a batch of commands
+     *
+     * Every command gets a section that starts with "# <command>"
+     * followed by its output. The output of all of them is flushed
+     * once at the end, so it's sent as one response.
+     *
+     * \param input Commands, separated by line breaks or ";;"
+     */
+    void parseBatch(const char* input) {
+        BatchPrint batch;
+        bool empty = true;
+
+        batch.out = output;
+        output    = &batch;
+
+        while (*input) {
+            while (*input == ' ') ++input;
+
+            const char* end = commandEnd(input);
+
+            if (end > input) {
+                batch.print("# ");
+                batch.write((const uint8_t*)input, end - input);
+                batch.print('\n');
+
+                cli.parse(input, end - input);
+                batch.flush();
+
+                empty = false;
+            }
+
+            input = end;
+
+            while ((*input == '\n') || (*input == '\r')) ++input;
+            if ((input[0] == ';') && (input[1] == ';')) input += 2;
+        }
+
+        output = batch.out;
+
+        if (empty) output->print("ERROR: batch needs commands, separated by line breaks or \";;\"");
+        output->flush();
     }
 
     // ===== PUBLIC ===== //
@@ -83,6 +212,36 @@ namespace cli {
             print(res);
         });
 
+        /**
+         * \brief Create arena command
+         *
+         * Prints the peak usage of the memory arenas of the
+         * script parser and the command line parser
+         */
+        cli.addCommand("arena", [](cmd* c) {
+            String res = arenaToString("duckparser", duckparser::getArena());
+            res += "\n";
+            res += arenaToString("cli", parser_get_arena());
+            print(res);
+        });
+
+        /**
+         * \brief Create hid command
+         *
+         * Prints the queue of HID reports and how fast
+         * they were sent since the last script started
+         */
+        cli.addCommand("hid", [](cmd* c) {
+            String res;
+
+            res += "queued: " + String(keyboard::queued()) + "/" + String(KEYBOARD_QUEUE_SIZE) + "\n";
+            res += "high water: " + String(keyboard::getHighWater()) + "\n";
+            res += "sent: " + String(keyboard::getSent()) + "\n";
+            res += "rate: " + String(keyboard::getReportsPerSecond()) + " reports/s";
+
+            print(res);
+        });
+
         /**
          * \brief Create version command
          *
@@ -100,7 +259,8 @@ namespace cli {
          */
         cli.addCommand("settings", [](cmd* c) {
             settings::load();
-            print(settings::toString());
+            settings::print(*output);
+            output->flush();
         });
 
         /**
@@ -138,14 +298,17 @@ namespace cli {
          */
         cli.addCommand("reset", [](cmd* c) {
             settings::reset();
-            print(settings::toString());
+            settings::print(*output);
+            output->flush();
         });
 
         /**
          * \brief Create status command
          *
          * Prints status of i2c connection to atmega32u4:
-         * running <script>
+         * running <script> (line <n>)
+         * replaying <trace>
+         * uploading <file> (<received>/<size> bytes)
          * connected
          * i2c connection problem
          */
@@ -153,7 +316,14 @@ namespace cli {
             if (true) {
                 if (duckscript::isRunning()) {
                     String s = "running " + duckscript::currentScript();
+                    uint32_t line = duckscript::currentLine();
+
+                    if (line > 0) s += " (line " + String(line) + ")";
                     print(s);
+                } else if (tracer::replaying()) {
+                    print("replaying " + tracer::currentReplay());
+                } else if (upload::uploading()) {
+                    print("uploading " + upload::currentUpload() + " (" + String(upload::getReceived()) + "/" + String(upload::getSize()) + " bytes)");
                 } else {
                     print("connected");
                 }
@@ -165,7 +335,8 @@ namespace cli {
         /**
          * \brief Create ls command
          *
-         * Prints a list of files inside of a given directory
+         * Prints a list of files inside of a given directory,
+         * compressed scripts with their uncompressed size in brackets
          *
          * \param * Path to directory
          */
@@ -173,14 +344,15 @@ namespace cli {
             Command  cmd { c };
             Argument arg { cmd.getArg(0) };
 
-            String res = spiffs::listDir(arg.getValue());
-            print(res);
+            spiffs::listDir(arg.getValue(), *output);
+            output->flush();
         });
 
         /**
          * \brief Create mem command
          *
          * Prints memory usage of SPIFFS
+         * and the space compressed scripts save
          */
         cli.addCommand("mem", [](cmd* c) {
             String s = "";
@@ -193,9 +365,44 @@ namespace cli {
             s += String(spiffs::freeBytes());
             s += " byte free";
 
+            size_t compressed, uncompressed;
+
+            spiffs::compressedBytes(compressed, uncompressed);
+
+            if (compressed > 0) {
+                s += "\n";
+                s += String(compressed);
+                s += " byte compressed scripts (";
+                s += String(uncompressed);
+                s += " byte uncompressed)";
+            }
+
             print(s);
         });
 
+        /**
+         * \brief Create fsbench command
+         *
+         * Measures open latency, sequential read and write
+         * throughput and the time of ls on the file system
+         */
+        cli.addCommand("fsbench", [](cmd* c) {
+            print(spiffs::benchmark());
+        });
+
+        /**
+         * \brief Create bench command
+         *
+         * Measures the parser, the keyboard, the file system
+         * and the web socket and prints the results as JSON,
+         * so firmware builds and boards can be compared.
+         * The results follow once loop() ran the benchmark.
+         */
+        cli.addCommand("bench", [](cmd* c) {
+            benchmark::request();
+            print("> bench started");
+        });
+
         /**
          * \brief Create cat command
          *
@@ -207,22 +414,18 @@ namespace cli {
             Command  cmd { c };
             Argument arg { cmd.getArg(0) };
 
-            File f = spiffs::open(arg.getValue());
+            reader::reader_t r;
+            reader::begin(r, spiffs::openRead(arg.getValue()));
 
-            int buf_size { 256 };
-            char buffer[buf_size];
+            uint8_t buffer[256];
+            size_t  len;
 
-            while (f && f.available()) {
-                for (size_t i = 0; i<buf_size; ++i) {
-                    if (!f.available() || (i == buf_size-1)) {
-                        buffer[i] = '\0';
-                        i         = buf_size;
-                    } else {
-                        buffer[i] = f.read();
-                    }
-                }
-                print(buffer);
+            while ((len = reader::read(r, buffer, sizeof(buffer))) > 0) {
+                output->write(buffer, len);
             }
+
+            reader::close(r);
+            output->flush();
         });
 
         /**
@@ -242,6 +445,49 @@ namespace cli {
             print(response);
         });
 
+        /**
+         * \brief Create resume command
+         *
+         * Starts executing a ducky script at a specific line,
+         * using the locale and default delay of the lines before it.
+         * Prints an error when the script doesn't have the line
+         *
+         * \param file Path to script in SPIFFS
+         * \param line Line to start at
+         */
+        Command cmdResume {
+            cli.addCommand("resume", [](cmd* c) {
+                Command  cmd { c };
+
+                Argument argFileName { cmd.getArg(0) };
+                Argument argLine { cmd.getArg(1) };
+
+                String fileName { argFileName.getValue() };
+                String lineStr { argLine.getValue() };
+
+                char* end;
+                uint32_t line = strtoul(lineStr.c_str(), &end, 10);
+
+                if (!isdigit(lineStr[0]) || (line == 0) || (*end != '\0')) {
+                    print("ERROR: \"" + lineStr + "\" isn't a line");
+                    return;
+                }
+
+                duckscript::run(fileName, line);
+
+                // Skipping to the line stops the script when it doesn't have it
+                if (!duckscript::isRunning()) {
+                    print("ERROR: \"" + fileName + "\" doesn't have line " + String(line));
+                    return;
+                }
+
+                String response = "> started \"" + fileName + "\" at line " + String(line);
+                print(response);
+            })
+        };
+        cmdResume.addPosArg("f/ile");
+        cmdResume.addPosArg("l/ine", "1");
+
         /**
          * \brief Create stop command
          *
@@ -256,10 +502,62 @@ namespace cli {
 
             duckscript::stop(arg.getValue());
 
+            if ((arg.getValue().length() == 0) || (arg.getValue() == tracer::currentReplay())) {
+                tracer::stopReplay();
+            }
+
             String response = "> stopped " + arg.getValue();
             print(response);
         });
 
+        /**
+         * \brief Create trace command
+         *
+         * Records every HID report that is sent, with the time
+         * it was sent at, into a file in SPIFFS
+         *
+         * \param * Path to the trace file
+         *          If no path is given, stop tracing
+         */
+        cli.addSingleArgCmd("trace", [](cmd* c) {
+            Command  cmd { c };
+            Argument arg { cmd.getArg(0) };
+
+            if (arg.getValue().length() > 0) {
+                tracer::start(arg.getValue());
+
+                String response = tracer::tracing() ? "> tracing to \"" + arg.getValue() + "\"" : "> couldn't open \"" + arg.getValue() + "\"";
+                print(response);
+            } else {
+                tracer::stop();
+
+                String response = "> stopped trace (" + String(tracer::getRecorded()) + " reports, " + String(tracer::getDropped()) + " dropped)";
+                print(response);
+            }
+        });
+
+        /**
+         * \brief Create replay command
+         *
+         * Sends the reports of a trace again, with their original timing
+         *
+         * \param * Path to the trace file
+         */
+        cli.addSingleArgCmd("replay", [](cmd* c) {
+            Command  cmd { c };
+            Argument arg { cmd.getArg(0) };
+
+            if (duckscript::isRunning()) {
+                print("> can't replay while a script is running");
+                return;
+            }
+
+            tracer::replay(arg.getValue());
+
+            String response = tracer::replaying() ? "> replaying \"" + arg.getValue() + "\"" : "> invalid trace \"" + arg.getValue() + "\"";
+            print(response);
+        });
+
         /**
          * \brief Create create command
          *
@@ -289,6 +587,8 @@ namespace cli {
             Argument arg { cmd.getArg(0) };
 
             spiffs::remove(arg.getValue());
+            duckcompiler::invalidate(arg.getValue());
+            layouts::invalidate(arg.getValue());
 
             String response = "> removed file \"" + arg.getValue() + "\"";
             print(response);
@@ -313,6 +613,10 @@ namespace cli {
                 String fileB { argB.getValue() };
 
                 spiffs::rename(fileA, fileB);
+                duckcompiler::invalidate(fileA);
+                duckcompiler::invalidate(fileB);
+                layouts::invalidate(fileA);
+                layouts::invalidate(fileB);
 
                 String response = "> renamed \"" + fileA + "\" to \"" + fileB + "\"";
                 print(response);
@@ -340,6 +644,8 @@ namespace cli {
                 String content { argContent.getValue() };
 
                 spiffs::write(fileName, (uint8_t*)content.c_str(), content.length());
+                duckcompiler::invalidate(fileName);
+                layouts::invalidate(fileName);
 
                 String response = "> wrote to file \"" + fileName + "\"";
                 print(response);
@@ -348,6 +654,35 @@ namespace cli {
         cmdWrite.addPosArg("f/ile");
         cmdWrite.addPosArg("c/ontent");
 
+        /**
+         * \brief Create upload command
+         *
+         * Starts an upload over the web socket, or continues it
+         * when it's the same file. The data is sent in binary frames,
+         * the protocol is described in upload.h
+         *
+         * \param file Path to file
+         * \param size Size of the file in bytes
+         * \param crc  crc32 of the file in hex
+         */
+        Command cmdUpload {
+            cli.addCommand("upload", [](cmd* c) {
+                Command cmd { c };
+
+                Argument argFileName { cmd.getArg(0) };
+                Argument argSize { cmd.getArg(1) };
+                Argument argCrc { cmd.getArg(2) };
+
+                uint32_t size = strtoul(argSize.getValue().c_str(), NULL, 10);
+                uint32_t crc  = strtoul(argCrc.getValue().c_str(), NULL, 16);
+
+                print(upload::start(argFileName.getValue(), size, crc, webserver::currentClientId()));
+            })
+        };
+        cmdUpload.addPosArg("f/ile");
+        cmdUpload.addPosArg("s/ize");
+        cmdUpload.addPosArg("c/rc");
+
         /**
          * \brief Create format command
          *
@@ -355,6 +690,7 @@ namespace cli {
          */
         cli.addCommand("format", [](cmd* c) {
             spiffs::format();
+            layouts::clearCache();
             print("Formatted SPIFFS");
         });
 
@@ -372,6 +708,8 @@ namespace cli {
             Argument arg { cmd.getArg(0) };
 
             spiffs::streamOpen(arg.getValue());
+            duckcompiler::invalidate(arg.getValue());
+            layouts::invalidate(arg.getValue());
 
             String response = "> opened stream \"" + arg.getValue() + "\"";
             print(response);
@@ -405,10 +743,34 @@ namespace cli {
                 print("> END");
             }
         });
+
+        /**
+         * \brief Create batch command
+         *
+         * Runs commands and sends their output as one response,
+         * see parseBatch(). A line that starts with "batch " is passed
+         * on as a whole by parse(), this only sees the rest of its line.
+         *
+         * \param * Commands, separated by line breaks or ";;"
+         */
+        cli.addSingleArgCmd("batch", [](cmd* c) {
+            Command  cmd { c };
+            Argument arg { cmd.getArg(0) };
+
+            parseBatch(arg.getValue().c_str());
+        });
+
+        /**
+         * \brief Sort the command names
+         *
+         * A line is dispatched by looking its first word up in the
+         * sorted names, instead of trying every command
+         */
+        cli.buildIndex();
     }
 
-    void parse(const char* input, PrintFunction printfunc, bool echo) {
-        cli::printfunc = printfunc;
+    void parse(const char* input, Print& out, bool echo) {
+        output = &out;
 
         if (spiffs::streaming() &&
             (strcmp(input, "close\n") != 0) &&
@@ -417,11 +779,16 @@ namespace cli {
             print("> Written data to file");
         } else {
             if (echo) {
-                String s = "# " + String(input);
-                print(s);
+                out.print("# ");
+                out.print(input);
+                out.flush();
             }
 
-            cli.parse(input);
+            if ((strncmp(input, "batch", 5) == 0) && ((input[5] == ' ') || (input[5] == '\n') || (input[5] == '\r'))) {
+                parseBatch(&input[6]);
+            } else {
+                cli.parse(input);
+            }
         }
     }
 }
\ No newline at end of file
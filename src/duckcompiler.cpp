@@ -0,0 +1,248 @@
+/*
+   This software is licensed under the MIT License. See the license file for details.
+   Source: https://github.com/spacehuhntech/WiFiDuck
+ */
+
+#include "duckcompiler.h"
+#include "duckparser.h"
+#include "config.h"
+#include "debug.h"
+
+#include "spiffs.h"
+#include "reader.h"
+
+namespace duckcompiler {
+    // ===== PRIVATE ===== //
+    File out;
+    File index;
+    bool outError = false;
+
+    uint32_t prevStart = 0; // Start of the code of the last line a REPEAT refers to
+    uint32_t prevEnd   = 0; // End of the code of that line
+    bool     repeated  = false;
+
+    reader::reader_t src; // Script that is compiled
+
+    header_t makeHeader(File& src) {
+        header_t h;
+
+        memcpy(h.magic, DUCKC_MAGIC, sizeof(h.magic));
+        h.version = DUCKC_VERSION;
+        memset(h.reserved, 0, sizeof(h.reserved));
+        h.src_size = src.size();
+        h.src_time = (uint32_t)src.getLastWrite();
+
+        return h;
+    }
+
+    void emit(uint8_t code, const uint8_t* data, size_t len) {
+        if ((code & ~OP_FLAG_DELAY) == OP_REPEAT) {
+            // REPEAT gets the location of the code it has to repeat
+            uint8_t repeat[OP_HEADER_SIZE + 12] = { 0 };
+
+            repeat[0] = code;
+            repeat[1] = 12;
+            memcpy(&repeat[2], data, _min(len, sizeof(uint32_t)));
+            memcpy(&repeat[6], &prevStart, sizeof(uint32_t));
+            memcpy(&repeat[10], &prevEnd, sizeof(uint32_t));
+
+            if (out.write(repeat, sizeof(repeat)) != sizeof(repeat)) outError = true;
+            repeated = true;
+        } else {
+            uint8_t head[OP_HEADER_SIZE] = { code, (uint8_t)len };
+
+            if (out.write(head, OP_HEADER_SIZE) != OP_HEADER_SIZE) outError = true;
+            if (out.write(data, len) != len) outError = true;
+        }
+    }
+
+    String replaceExtension(String fileName, const char* extension) {
+        int dot   = fileName.lastIndexOf('.');
+        int slash = fileName.lastIndexOf('/');
+
+        if (dot > slash) fileName = fileName.substring(0, dot);
+
+        return fileName + extension;
+    }
+
+    // Checks that a file starts with the header h
+    bool hasHeader(String fileName, const header_t& h) {
+        if (!spiffs::exists(fileName)) return false;
+
+        File     f = spiffs::openPooled(fileName);
+        header_t prev;
+
+        bool valid = f && (f.read((uint8_t*)&prev, sizeof(header_t)) == sizeof(header_t)) &&
+                     (memcmp(&prev, &h, sizeof(header_t)) == 0);
+
+        return valid;
+    }
+
+    // Number of lines in an index file
+    uint32_t indexLines(File& f) {
+        return (f.size() - sizeof(header_t)) / sizeof(uint32_t);
+    }
+
+    uint32_t indexEntry(File& f, uint32_t i) {
+        uint32_t offset = 0;
+
+        f.seek(sizeof(header_t) + i * sizeof(uint32_t), SeekSet);
+        f.read((uint8_t*)&offset, sizeof(uint32_t));
+
+        return offset;
+    }
+
+    // ===== PUBLIC ===== //
+    String codeName(String fileName) {
+        return replaceExtension(fileName, DUCKC_EXTENSION);
+    }
+
+    String indexName(String fileName) {
+        return replaceExtension(fileName, DUCKL_EXTENSION);
+    }
+
+    bool isCode(String fileName) {
+        return fileName.endsWith(DUCKC_EXTENSION);
+    }
+
+    String compile(String fileName) {
+        if (isCode(fileName)) return fileName;
+
+        reader::begin(src, spiffs::openPooled(fileName));
+
+        if (!src.file) return String();
+
+        header_t h       = makeHeader(src.file);
+        String   outName = codeName(fileName);
+
+        // Use existing code when the source didn't change
+        String idxName = indexName(fileName);
+
+        if (hasHeader(outName, h) && hasHeader(idxName, h)) {
+            reader::close(src);
+            return outName;
+        }
+
+        spiffs::remove(outName);
+        spiffs::remove(idxName);
+
+        debugf("Compiling %s\n", fileName.c_str());
+
+        out      = spiffs::openWrite(outName);
+        index    = spiffs::openWrite(idxName);
+        outError = !out || (out.write((uint8_t*)&h, sizeof(header_t)) != sizeof(header_t)) ||
+                   !index || (index.write((uint8_t*)&h, sizeof(header_t)) != sizeof(header_t));
+
+        prevStart = prevEnd = out ? out.position() : 0;
+
+        duckparser::reset();
+
+        // Compile line by line, the same way they'd be interpreted
+        uint32_t lineStart = prevStart;
+        bool     newLine   = true;
+        bool     lineFeed  = true; // The next line is a new line of the source
+        bool     blank     = false;
+
+        while (!outError) {
+            if (src.i == src.len) reader::fill(src);
+            if (src.i == src.len) break;
+
+            if (newLine) {
+                lineStart = out.position();
+                blank     = (src.buf[src.i] == '\n') || (src.buf[src.i] == '\r');
+                repeated  = false;
+
+                // A \r\n line break only starts one line of the source
+                if (lineFeed && (index.write((uint8_t*)&lineStart, sizeof(uint32_t)) != sizeof(uint32_t))) outError = true;
+            }
+
+            size_t n = duckparser::feed(&src.buf[src.i], src.len - src.i, reader::last(src), emit);
+
+            // The line continues after buf
+            if (n == 0) {
+                reader::fill(src);
+                n = duckparser::feed(&src.buf[src.i], src.len - src.i, reader::last(src), emit);
+            }
+
+            src.i   += n;
+            newLine  = (n > 0) && ((src.buf[src.i - 1] == '\n') || (src.buf[src.i - 1] == '\r') || ((src.i == src.len) && reader::last(src)));
+            lineFeed = newLine && (src.buf[src.i - 1] != '\r');
+
+            // Remember the code of this line in case a REPEAT follows
+            if (newLine && !repeated && !blank) {
+                prevStart = lineStart;
+                prevEnd   = out.position();
+            }
+        }
+
+        duckparser::reset();
+
+        // Code of a truncated .duckz would look complete
+        if (src.decoder && src.decoder->eof) {
+            debugln("Compressed script is truncated");
+            outError = true;
+        }
+
+        reader::close(src);
+        if (out) out.close();
+        if (index) index.close();
+
+        if (outError) {
+            debugln("Compiling failed");
+            spiffs::remove(outName);
+            spiffs::remove(idxName);
+            return String();
+        }
+
+        return outName;
+    }
+
+    void invalidate(String fileName) {
+        if (!isCode(fileName)) {
+            spiffs::remove(codeName(fileName));
+            spiffs::remove(indexName(fileName));
+        }
+    }
+
+    // Offset of the code of a line (starting at 1),
+    // DUCKC_NO_LINE when there is no index or the script doesn't have the line
+    uint32_t lineOffset(String fileName, uint32_t line) {
+        File f = spiffs::openPooled(indexName(fileName));
+
+        if (!f) return DUCKC_NO_LINE;
+
+        uint32_t offset = DUCKC_NO_LINE;
+
+        if ((line > 0) && (f.size() >= sizeof(header_t)) && (line <= indexLines(f))) {
+            offset = indexEntry(f, line - 1);
+        }
+
+        return offset;
+    }
+
+    // Line (starting at 1) that the code at offset belongs to, 0 when there is no index
+    uint32_t lineAt(String fileName, uint32_t offset) {
+        File f = spiffs::openPooled(indexName(fileName));
+
+        if (!f) return 0;
+
+        uint32_t line = 0;
+
+        if (f.size() >= sizeof(header_t)) {
+            // Last line that starts at or before offset
+            uint32_t a = 0;
+            uint32_t b = indexLines(f);
+
+            while (a < b) {
+                uint32_t m = a + (b - a) / 2;
+
+                if (indexEntry(f, m) <= offset) a = m + 1;
+                else b = m;
+            }
+
+            line = a;
+        }
+
+        return line;
+    }
+}
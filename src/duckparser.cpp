@@ -9,8 +9,13 @@
 #include "config.h"
 // #include "debug.h"
 #include "keyboard.h"
+#include "keynames.h"
+#include "layouts.h"
 #include "led.h"
-#include "webserver.h"
+
+extern "C" {
+#include "c/arena.h" // arena_alloc
+}
 
 #include <stdlib.h>  // malloc
 #include <string.h>  // strlen
@@ -36,22 +41,12 @@ typedef struct word_list {
     size_t            size;
 } word_list;
 
-typedef struct line_node {
-    const char      * str;
-    size_t            len;
-    struct word_list* words;
-    struct line_node* next;
-} line_node;
-
-typedef struct line_list {
-    struct line_node* first;
-    struct line_node* last;
-    size_t            size;
-} line_list;
-
-
 namespace duckparser {
   
+// ===== Arena ===== //
+void* arenaBuf[DUCKPARSER_ARENA_SIZE / sizeof(void*)];
+arena parseArena = { (uint8_t*)arenaBuf, sizeof(arenaBuf), 0, 0, 0 };
+
 int compare(const char* user_str, size_t user_str_len, const char* templ_str, int case_sensetive);
 // ===== Word Node ===== //
 word_node* word_node_create(const char* str, size_t len);
@@ -65,21 +60,8 @@ word_list* word_list_destroy(word_list* l);
 void word_list_push(word_list* l, word_node* n);
 word_node* word_list_get(word_list* l, size_t i);
 
-// ===== Line Node ==== //
-line_node* line_node_create(const char* str, size_t len);
-word_node* line_node_destroy(line_node* n);
-word_node* line_node_destroy_rec(line_node* n);
-
-// ===== Line List ===== //
-line_list* line_list_create();
-line_list* line_list_destroy(line_list* l);
-
-void line_list_push(line_list* l, line_node* n);
-line_node* line_list_get(line_list* l, size_t i);
-
 // ===== Parser ===== //
 word_list* parse_words(const char* str, size_t len);
-line_list* parse_lines(const char* str, size_t len);
   ////////////////////////////////////////////////////////////////////////parser.c////////////////////////////////////////////////////////////////////////////////////
 
 // My own implementation, because the default one in ctype.h make problems on older ESP8266 SDKs
@@ -90,6 +72,13 @@ char to_lower(char c) {
     return c;
 }
 
+char to_upper(char c) {
+    if ((c >= 97) && (c <= 122)) {
+        return (char)(c - 32);
+    }
+    return c;
+}
+
 int compare(const char* user_str, size_t user_str_len, const char* templ_str, int case_sensetive) {
     if (user_str == templ_str) return COMPARE_EQUAL;
 
@@ -164,7 +153,7 @@ int compare(const char* user_str, size_t user_str_len, const char* templ_str, in
 
 // ===== Word Node ===== //
 word_node* word_node_create(const char* str, size_t len) {
-    word_node* n = (word_node*)malloc(sizeof(word_node));
+    word_node* n = (word_node*)arena_alloc(&parseArena, sizeof(word_node));
 
     n->str  = str;
     n->len  = len;
@@ -174,7 +163,7 @@ word_node* word_node_create(const char* str, size_t len) {
 
 word_node* word_node_destroy(word_node* n) {
     if (n) {
-        free(n);
+        arena_free(&parseArena, n);
     }
     return NULL;
 }
@@ -189,7 +178,7 @@ word_node* word_node_destroy_rec(word_node* n) {
 
 // ===== Word List ===== //
 word_list* word_list_create() {
-    word_list* l = (word_list*)malloc(sizeof(word_list));
+    word_list* l = (word_list*)arena_alloc(&parseArena, sizeof(word_list));
 
     l->first = NULL;
     l->last  = NULL;
@@ -200,7 +189,7 @@ word_list* word_list_create() {
 word_list* word_list_destroy(word_list* l) {
     if (l) {
         word_node_destroy_rec(l->first);
-        free(l);
+        arena_free(&parseArena, l);
     }
     return NULL;
 }
@@ -231,79 +220,6 @@ word_node* word_list_get(word_list* l, size_t i) {
     return h;
 }
 
-// ===== Line Node ==== //
-line_node* line_node_create(const char* str, size_t len) {
-    line_node* n = (line_node*)malloc(sizeof(line_node));
-
-    n->str   = str;
-    n->len   = len;
-    n->words = NULL;
-    n->next  = NULL;
-
-    return n;
-}
-
-word_node* line_node_destroy(line_node* n) {
-    if (n) {
-        word_list_destroy(n->words);
-        free(n);
-    }
-    return NULL;
-}
-
-word_node* line_node_destroy_rec(line_node* n) {
-    if (n) {
-        line_node_destroy_rec(n->next);
-        line_node_destroy(n);
-    }
-    return NULL;
-}
-
-// ===== Line List ===== //
-line_list* line_list_create() {
-    line_list* l = (line_list*)malloc(sizeof(line_list));
-
-    l->first = NULL;
-    l->last  = NULL;
-    l->size  = 0;
-
-    return l;
-}
-
-line_list* line_list_destroy(line_list* l) {
-    if (l) {
-        line_node_destroy_rec(l->first);
-        free(l);
-    }
-    return NULL;
-}
-
-void line_list_push(line_list* l, line_node* n) {
-    if (l && n) {
-        if (l->last) {
-            l->last->next = n;
-        } else {
-            l->first = n;
-        }
-
-        l->last = n;
-        ++l->size;
-    }
-}
-
-line_node* line_list_get(line_list* l, size_t i) {
-    if (!l) return NULL;
-
-    size_t j;
-    line_node* h = l->first;
-
-    for (j = 0; j < i && h; ++j) {
-        h = h->next;
-    }
-
-    return h;
-}
-
 // ===== Parser ===== //
 word_list* parse_words(const char* str, size_t len) {
     word_list* l = word_list_create();
@@ -342,123 +258,112 @@ word_list* parse_words(const char* str, size_t len) {
     return l;
 }
 
-line_list* parse_lines(const char* str, size_t len) {
-    line_list* l = line_list_create();
+  ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // ====== PRIVATE ===== //
+    bool processing = false;
 
-    if (len == 0) return l;
+    // State of the tokenizer between two feed() calls
+    typedef enum stream_state {
+        STREAM_LINE,    // At the start of a line
+        STREAM_STRING,  // In the text of a STRING
+        STREAM_COMMENT, // In the text of a REM
+        STREAM_KEYS,    // In a line of keys, the instruction in op_buf isn't finished yet
+        STREAM_SKIP     // In the rest of a line that is too long to be used
+    } stream_state;
 
-    // Go through string and look for \r and \n to split it into lines
-    line_node* n = NULL;
+    stream_state streamState = STREAM_LINE;
 
-    size_t stri = 0; // current index
-    size_t ls   = 0; // start index of line
+    int defaultDelay = 5;
+    int repeatNum    = 0;
 
-    bool escaped   = false;
-    bool in_quotes = false;
-    bool delimiter = false;
-    bool linebreak = false;
-    bool endofline = false;
+    unsigned long interpretTime  = 0;
+    unsigned long sleepStartTime = 0;
+    unsigned long sleepTime      = 0; // Duration, so millis() overflows don't matter
 
-    for (stri = 0; stri <= len; ++stri) {
-        char prev = stri > 0 ? str[stri-1] : 0;
-        char curr = str[stri];
-        char next = str[stri+1];
+    EmitFunction emitfunc = NULL;                // !< Receives every compiled instruction
+    uint8_t op_buf[OP_HEADER_SIZE + OP_MAX_LEN]; // !< Instruction that is currently compiled
 
-        escaped = prev == '\\';
+    uint32_t toU32(const uint8_t* data, size_t len) {
+        uint32_t val = 0;
 
-        // disabled because ducky script isn't using quotes
-        // in_quotes = (curr == '"' && !escaped) ? !in_quotes : in_quotes;
-        // delimiter = !in_quotes && !escaped && curr == ';' && next == ';';
+        if (len >= sizeof(uint32_t)) memcpy(&val, data, sizeof(uint32_t));
+        return val;
+    }
 
-        linebreak = !in_quotes && (curr == '\r' || curr == '\n');
+    void type(const char* str, size_t len) {
+        keyboard::write(str, len);
+    }
 
-        endofline = stri == len || curr == '\0';
+    void press(const uint8_t* items, size_t len) {
+        size_t i = 0;
 
-        if (linebreak || endofline || delimiter) {
-            size_t llen = stri - ls; // length of line
+        while (i + 1 < len) {
+            uint8_t item = items[i++];
 
-            // for every line, parse_words and add to list
-            if (llen > 0) {
-                n        = line_node_create(&str[ls], llen);
-                n->words = parse_words(&str[ls], llen);
-                line_list_push(l, n);
-            }
+            if (item == PRESS_KEY) {
+                keyboard::pressKey(items[i++]);
+            } else if (item == PRESS_MOD) {
+                keyboard::pressModifier(items[i++]);
+            } else if (item == PRESS_CHAR) {
+                // Zero terminated copy, so the locale lookup can't read into the next item
+                char c[5] = { 0 };
+                size_t char_len = _min(items[i], 4);
 
-            if (delimiter) ++stri;
+                ++i;
 
-            ls = stri+1; // reset start index of line
+                if (i + char_len > len) break;
+                memcpy(c, &items[i], char_len);
+                i += char_len;
+
+                keyboard::press(c);
+            } else {
+                break;
+            }
         }
     }
 
-    return l;
-}
-  ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-    // ====== PRIVATE ===== //
-    bool processing = false;
-    bool inString  = false;
-    bool inComment = false;
+    void release() {
+        keyboard::release();
+    }
 
-    int defaultDelay = 5;
-    int repeatNum    = 0;
+    uint32_t hashKey(const char* str, size_t len, uint32_t seed) {
+        // FNV-1a, has to match scripts/keynames.py
+        uint32_t h = 2166136261UL ^ seed;
 
-    unsigned long interpretTime  = 0;
-    unsigned long sleepStartTime = 0;
-    unsigned long sleepTime      = 0;
+        for (size_t i = 0; i < len; ++i) {
+            h ^= (uint8_t)to_upper(str[i]);
+            h *= 16777619UL;
+        }
 
-    void type(const char* str, size_t len) {
-        keyboard::write(str, len);
+        return h;
     }
 
-    void press(const char* str, size_t len) {
-        // character
-        if (len == 1) keyboard::press(str);
-
-        // Keys
-        else if (compare(str, len, "ENTER", CASE_SENSETIVE)) keyboard::pressKey(KEY_ENTER);
-        else if (compare(str, len, "MENU", CASE_SENSETIVE) || compare(str, len, "APP", CASE_SENSETIVE)) keyboard::pressKey(KEY_PROPS);
-        else if (compare(str, len, "DELETE", CASE_SENSETIVE)) keyboard::pressKey(KEY_BACKSPACE);
-        else if (compare(str, len, "HOME", CASE_SENSETIVE)) keyboard::pressKey(KEY_HOME);
-        else if (compare(str, len, "INSERT", CASE_SENSETIVE)) keyboard::pressKey(KEY_INSERT);
-        else if (compare(str, len, "PAGEUP", CASE_SENSETIVE)) keyboard::pressKey(KEY_PAGEUP);
-        else if (compare(str, len, "PAGEDOWN", CASE_SENSETIVE)) keyboard::pressKey(KEY_PAGEDOWN);
-        else if (compare(str, len, "UPARROW", CASE_SENSETIVE) || compare(str, len, "UP", CASE_SENSETIVE)) keyboard::pressKey(KEY_UP);
-        else if (compare(str, len, "DOWNARROW", CASE_SENSETIVE) || compare(str, len, "DOWN", CASE_SENSETIVE)) keyboard::pressKey(KEY_DOWN);
-        else if (compare(str, len, "LEFTARROW", CASE_SENSETIVE) || compare(str, len, "LEFT", CASE_SENSETIVE)) keyboard::pressKey(KEY_LEFT);
-        else if (compare(str, len, "RIGHTARROW", CASE_SENSETIVE) || compare(str, len, "RIGHT", CASE_SENSETIVE)) keyboard::pressKey(KEY_RIGHT);
-        else if (compare(str, len, "TAB", CASE_SENSETIVE)) keyboard::pressKey(KEY_TAB);
-        else if (compare(str, len, "END", CASE_SENSETIVE)) keyboard::pressKey(KEY_END);
-        else if (compare(str, len, "ESC", CASE_SENSETIVE) || compare(str, len, "ESCAPE", CASE_SENSETIVE)) keyboard::pressKey(KEY_ESC);
-        else if (compare(str, len, "F1", CASE_SENSETIVE)) keyboard::pressKey(KEY_F1);
-        else if (compare(str, len, "F2", CASE_SENSETIVE)) keyboard::pressKey(KEY_F2);
-        else if (compare(str, len, "F3", CASE_SENSETIVE)) keyboard::pressKey(KEY_F3);
-        else if (compare(str, len, "F4", CASE_SENSETIVE)) keyboard::pressKey(KEY_F4);
-        else if (compare(str, len, "F5", CASE_SENSETIVE)) keyboard::pressKey(KEY_F5);
-        else if (compare(str, len, "F6", CASE_SENSETIVE)) keyboard::pressKey(KEY_F6);
-        else if (compare(str, len, "F7", CASE_SENSETIVE)) keyboard::pressKey(KEY_F7);
-        else if (compare(str, len, "F8", CASE_SENSETIVE)) keyboard::pressKey(KEY_F8);
-        else if (compare(str, len, "F9", CASE_SENSETIVE)) keyboard::pressKey(KEY_F9);
-        else if (compare(str, len, "F10", CASE_SENSETIVE)) keyboard::pressKey(KEY_F10);
-        else if (compare(str, len, "F11", CASE_SENSETIVE)) keyboard::pressKey(KEY_F11);
-        else if (compare(str, len, "F12", CASE_SENSETIVE)) keyboard::pressKey(KEY_F12);
-        else if (compare(str, len, "SPACE", CASE_SENSETIVE)) keyboard::pressKey(KEY_SPACE);
-        else if (compare(str, len, "PAUSE", CASE_SENSETIVE) || compare(str, len, "BREAK", CASE_SENSETIVE)) keyboard::pressKey(KEY_PAUSE);
-        else if (compare(str, len, "CAPSLOCK", CASE_SENSETIVE)) keyboard::pressKey(KEY_CAPSLOCK);
-        else if (compare(str, len, "NUMLOCK", CASE_SENSETIVE)) keyboard::pressKey(KEY_NUMLOCK);
-        else if (compare(str, len, "PRINTSCREEN", CASE_SENSETIVE)) keyboard::pressKey(KEY_SYSRQ);
-        else if (compare(str, len, "SCROLLLOCK", CASE_SENSETIVE)) keyboard::pressKey(KEY_SCROLLLOCK);
-
-        // Modifiers
-        else if (compare(str, len, "CTRL", CASE_SENSETIVE) || compare(str, len, "CONTROL", CASE_SENSETIVE)) keyboard::pressModifier(KEY_MOD_LCTRL);
-        else if (compare(str, len, "SHIFT", CASE_SENSETIVE)) keyboard::pressModifier(KEY_MOD_LSHIFT);
-        else if (compare(str, len, "ALT", CASE_SENSETIVE)) keyboard::pressModifier(KEY_MOD_LALT);
-        else if (compare(str, len, "WINDOWS", CASE_SENSETIVE) || compare(str, len, "GUI", CASE_SENSETIVE)) keyboard::pressModifier(KEY_MOD_LMETA);
-
-        // Utf8 character
-        else keyboard::press(str);
+    bool lookupKey(const char* str, size_t len, uint8_t* key, uint8_t* mod) {
+        size_t   bucket = hashKey(str, len, 0) % KEYNAMES_BUCKETS;
+        uint16_t seed   = pgm_read_word(&keynames_seeds[bucket]);
+
+        keyname_t k;
+
+        memcpy_P(&k, &keynames[hashKey(str, len, seed) % KEYNAMES_LEN], sizeof(keyname_t));
+
+        // The perfect hash maps every name to a slot, make sure it's the right one
+        if (k.name_len != len) return false;
+
+        for (size_t i = 0; i < len; ++i) {
+            if (to_upper(str[i]) != (char)pgm_read_byte(&keynames_pool[k.name + i])) return false;
+        }
+
+        *key = k.key;
+        *mod = k.modifiers;
+
+        return true;
     }
 
-    void release() {
-        keyboard::release();
+    // Compiled in layouts, or the ones uploaded as /NAME.layout
+    void setLocale(const char* str, size_t len) {
+        hid_locale_t* locale = layouts::get(str, len);
+
+        if (locale) keyboard::setLocale(locale);
     }
 
     unsigned int toInt(const char* str, size_t len) {
@@ -490,171 +395,475 @@ line_list* parse_lines(const char* str, size_t len) {
         return val;
     }
 
+    // Doesn't block, the script continues when getDelayTime() reached 0
     void sleep(unsigned long time) {
         unsigned long offset = millis() - interpretTime;
 
+        // The delay starts after the queued reports are typed
+        time += keyboard::getPendingTime();
+
         if (time > offset) {
             sleepStartTime = millis();
-            //sleepTime      = time - offset;
-            sleepTime      = time - offset + sleepStartTime;
+            sleepTime      = time - offset;
+        }
+    }
+
+    // ===== Compiler ===== //
+    void op_begin(uint8_t code) {
+        op_buf[0] = code;
+        op_buf[1] = 0;
+    }
+
+    bool op_fits(size_t len) {
+        return op_buf[1] + len <= OP_MAX_LEN;
+    }
+
+    void op_push(const void* data, size_t len) {
+        memcpy(&op_buf[OP_HEADER_SIZE + op_buf[1]], data, len);
+        op_buf[1] += len;
+    }
+
+    void op_push_u32(uint32_t val) {
+        op_push(&val, sizeof(uint32_t));
+    }
+
+    void op_end(bool delay) {
+        if (delay) op_buf[0] |= OP_FLAG_DELAY;
+        if (emitfunc) emitfunc(op_buf[0], &op_buf[OP_HEADER_SIZE], op_buf[1]);
+    }
 
-            //delay(sleepTime);
-            while(millis() < sleepTime)
-            {
-                webserver::update();
+    // Length of the longest beginning of str that doesn't end in the middle of a utf8 character
+    size_t utf8_cut(const char* str, size_t len) {
+        for (size_t i = 1; i <= 3 && i <= len; ++i) {
+            uint8_t c = (uint8_t)str[len - i];
+
+            // Continuation byte, keep looking for the first byte
+            if ((c & 0xC0) == 0x80) continue;
+
+            size_t char_len = 1;
+
+            if ((c & 0xE0) == 0xC0) char_len = 2;
+            else if ((c & 0xF0) == 0xE0) char_len = 3;
+            else if ((c & 0xF8) == 0xF0) char_len = 4;
+
+            return (char_len > i) ? len - i : len;
+        }
+
+        return len;
+    }
+
+    // Emits the text of a STRING straight from str, no copy
+    // Returns how many bytes were used, the rest of an unfinished character is left over
+    size_t compile_string(const char* str, size_t len, bool line_end) {
+        size_t used = 0;
+
+        while ((len - used > OP_MAX_LEN) || (!line_end && (used < len))) {
+            size_t n = utf8_cut(&str[used], _min(len - used, OP_MAX_LEN));
+
+            if (n == 0) {
+                // Not enough bytes to finish the character, wait for the rest
+                if (len - used < OP_MAX_LEN) break;
+                n = OP_MAX_LEN;
             }
+
+            if (emitfunc) emitfunc(OP_STRING, (const uint8_t*)&str[used], n);
+            used += n;
+        }
+
+        // Only the end of the line gets the default delay
+        if (line_end) {
+            if (emitfunc) emitfunc(OP_STRING | OP_FLAG_DELAY, (const uint8_t*)&str[used], len - used);
+            used = len;
         }
+
+        return used;
     }
 
-    // ====== PUBLIC ===== //
+    // Appends a press item for a key name, modifier name or character to the current instruction
+    void compile_press(const char* str, size_t len) {
+        uint8_t key = KEY_NONE;
+        uint8_t mod = KEY_NONE;
+
+        // Single characters are resolved with the locale at run time
+        if (len > 1) lookupKey(str, len, &key, &mod);
+
+        uint8_t item[6];
+        size_t  item_len;
+
+        if (key != KEY_NONE) {
+            item[0]  = PRESS_KEY;
+            item[1]  = key;
+            item_len = 2;
+        } else if (mod != KEY_NONE) {
+            item[0]  = PRESS_MOD;
+            item[1]  = mod;
+            item_len = 2;
+        } else {
+            // Character or utf8 character, resolved with the locale at run time
+            item[0]  = PRESS_CHAR;
+            item[1]  = _min(len, 4);
+            memcpy(&item[2], str, item[1]);
+            item_len = 2 + item[1];
+        }
 
-    void parse(const char* str, size_t len) {
-        processing = true;
-        interpretTime = millis();
+        // Keys that don't fit are pressed by a HOLD instruction before this one
+        if (!op_fits(item_len)) {
+            op_end(false);
+            op_begin(OP_HOLD);
+        }
 
-        // Split str into a list of lines
-        line_list* l = parse_lines(str, len);
+        op_push(item, item_len);
+    }
+
+    // Adds every complete word of a line of keys to the instruction in op_buf
+    // Returns how many bytes were used, an unfinished word at the end is left over
+    size_t compile_keys(const char* str, size_t len, bool line_end) {
+        size_t j = 0; // start index of word
 
-        // Go through all lines
-        line_node* n = l->first;
+        for (size_t i = 0; i <= len; ++i) {
+            if ((i == len) && !line_end) break;
+
+            if ((i == len) || (str[i] == ' ')) {
+                if (i > j) compile_press(&str[j], i - j);
+                j = i + 1;
+            }
+        }
+
+        if (line_end) {
+            op_buf[0] = OP_PRESS;
+            op_end(true);
+            return len;
+        }
+
+        return j;
+    }
+
+    // Commands that need their whole line before they can be compiled
+    bool is_command(const char* str, size_t len) {
+        return compare(str, len, "LOCALE", CASE_SENSETIVE) ||
+               compare(str, len, "DELAY", CASE_SENSETIVE) ||
+               compare(str, len, "DEFAULTDELAY", CASE_SENSETIVE) ||
+               compare(str, len, "DEFAULT_DELAY", CASE_SENSETIVE) ||
+               compare(str, len, "REPEAT", CASE_SENSETIVE) ||
+               compare(str, len, "REPLAY", CASE_SENSETIVE) ||
+               compare(str, len, "LED", CASE_SENSETIVE) ||
+               compare(str, len, "OPTIMIZE", CASE_SENSETIVE) ||
+               compare(str, len, "KEYCODE", CASE_SENSETIVE);
+    }
+
+    // Compiles one complete line, without the line break
+    void compile_line(const char* str, size_t len) {
+        word_list* wl  = parse_words(str, len);
+        word_node* cmd = wl->first;
+
+        const char* line_str = cmd ? cmd->str + cmd->len + 1 : str;
+        size_t line_str_len  = (line_str < str + len) ? str + len - line_str : 0;
 
         // Flag, no default delay after this command
-        bool ignore_delay;
+        bool ignore_delay = false;
 
-        while (n) {
-            ignore_delay = false;
+        // Flag, the instruction in op_buf wasn't emitted yet
+        bool pending = false;
+
+        // Only whitespace (-> do nothing)
+        if (!cmd) {
+            ignore_delay = true;
+        }
 
-            word_list* wl  = n->words;
-            word_node* cmd = wl->first;
+        // REM (= Comment -> do nothing)
+        else if (compare(cmd->str, cmd->len, "REM", CASE_SENSETIVE)) {
+            ignore_delay = true;
+        }
 
-            const char* line_str = cmd->str + cmd->len + 1;
-            size_t line_str_len  = n->len - cmd->len - 1;
+        // STRING (-> type each character)
+        else if (compare(cmd->str, cmd->len, "STRING", CASE_SENSETIVE)) {
+            compile_string(line_str, line_str_len, true);
+        }
 
-            char last_char = n->str[n->len];
-            bool line_end  = last_char == '\r' || last_char == '\n';
+        // LOCALE (-> change keyboard layout)
+        else if (compare(cmd->str, cmd->len, "LOCALE", CASE_SENSETIVE)) {
+            word_node* w = cmd->next;
 
-            // REM (= Comment -> do nothing)
-            if (inComment || compare(cmd->str, cmd->len, "REM", CASE_SENSETIVE)) {
-                inComment    = !line_end;
-                ignore_delay = true;
+            if (w) {
+                op_begin(OP_LOCALE);
+                op_push(w->str, _min(w->len, OP_MAX_LEN));
+                pending = true;
             }
+            ignore_delay = true;
+        }
+
+        // DELAY (-> sleep for x ms)
+        else if (compare(cmd->str, cmd->len, "DELAY", CASE_SENSETIVE)) {
+            op_begin(OP_DELAY);
+            op_push_u32(toInt(line_str, line_str_len));
+            pending      = true;
+            ignore_delay = true;
+        }
+
+        // DEFAULTDELAY/DEFAULT_DELAY (set default delay per command)
+        else if (compare(cmd->str, cmd->len, "DEFAULTDELAY", CASE_SENSETIVE) || compare(cmd->str, cmd->len, "DEFAULT_DELAY", CASE_SENSETIVE)) {
+            op_begin(OP_DEFAULTDELAY);
+            op_push_u32(toInt(line_str, line_str_len));
+            pending      = true;
+            ignore_delay = true;
+        }
+
+        // REPEAT (-> repeat last command n times)
+        else if (compare(cmd->str, cmd->len, "REPEAT", CASE_SENSETIVE) || compare(cmd->str, cmd->len, "REPLAY", CASE_SENSETIVE)) {
+            op_begin(OP_REPEAT);
+            op_push_u32(toInt(line_str, line_str_len));
+            pending      = true;
+            ignore_delay = true;
+        }
+
+        // OPTIMIZE ON/OFF (-> leave out releases between different keys)
+        else if (compare(cmd->str, cmd->len, "OPTIMIZE", CASE_SENSETIVE)) {
+            word_node* w  = cmd->next;
+            uint8_t    on = w && compare(w->str, w->len, "ON", CASE_SENSETIVE);
+
+            op_begin(OP_OPTIMIZE);
+            op_push(&on, 1);
+            pending      = true;
+            ignore_delay = true;
+        }
+
+        // LED
+        else if (compare(cmd->str, cmd->len, "LED", CASE_SENSETIVE)) {
+            word_node* w = cmd->next;
+
+            op_begin(OP_LED);
+
+            for (uint8_t i = 0; i<3; ++i) {
+                uint8_t c = 0;
 
-            // LOCALE (-> change keyboard layout)
-            else if (compare(cmd->str, cmd->len, "LOCALE", CASE_SENSETIVE)) {
-                word_node* w = cmd->next;
-
-                if (compare(w->str, w->len, "US", CASE_SENSETIVE)) {
-                    keyboard::setLocale(&locale_us);
-                } else if (compare(w->str, w->len, "DE", CASE_SENSETIVE)) {
-                    keyboard::setLocale(&locale_de);
-                } else if (compare(w->str, w->len, "RU", CASE_SENSETIVE)) {
-                    keyboard::setLocale(&locale_ru);
-                } else if (compare(w->str, w->len, "GB", CASE_SENSETIVE)) {
-                    keyboard::setLocale(&locale_gb);
-                } else if (compare(w->str, w->len, "ES", CASE_SENSETIVE)) {
-                    keyboard::setLocale(&locale_es);
-                } else if (compare(w->str, w->len, "FR", CASE_SENSETIVE)) {
-                    keyboard::setLocale(&locale_fr);
-                } else if (compare(w->str, w->len, "DK", CASE_SENSETIVE)) {
-                    keyboard::setLocale(&locale_dk);
+                if (w) {
+                    c = (uint8_t)toInt(w->str, w->len);
+                    w = w->next;
                 }
-                ignore_delay = true;
-            }
 
-            // DELAY (-> sleep for x ms)
-            else if (compare(cmd->str, cmd->len, "DELAY", CASE_SENSETIVE)) {
-                sleep(toInt(line_str, line_str_len));
-                ignore_delay = true;
+                op_push(&c, 1);
             }
 
-            // DEFAULTDELAY/DEFAULT_DELAY (set default delay per command)
-            else if (compare(cmd->str, cmd->len, "DEFAULTDELAY", CASE_SENSETIVE) || compare(cmd->str, cmd->len, "DEFAULT_DELAY", CASE_SENSETIVE)) {
-                defaultDelay = toInt(line_str, line_str_len);
-                ignore_delay = true;
+            pending = true;
+        }
+
+        // KEYCODE
+        else if (compare(cmd->str, cmd->len, "KEYCODE", CASE_SENSETIVE)) {
+            word_node* w = cmd->next;
+
+            if (w) {
+                op_begin(OP_KEYCODE);
+
+                // Modifiers and 6 keys
+                for (uint8_t i = 0; i<7; ++i) {
+                    uint8_t k = KEY_NONE;
+
+                    if (w) {
+                        k = (uint8_t)toInt(w->str, w->len);
+                        w = w->next;
+                    }
+
+                    op_push(&k, 1);
+                }
+
+                pending = true;
             }
+        }
+
+        // Otherwise go through words and look for keys to press
+        else {
+            word_node* w = wl->first;
+
+            op_begin(OP_PRESS);
 
-            // REPEAT (-> repeat last command n times)
-            else if (compare(cmd->str, cmd->len, "REPEAT", CASE_SENSETIVE) || compare(cmd->str, cmd->len, "REPLAY", CASE_SENSETIVE)) {
-                repeatNum    = toInt(line_str, line_str_len) + 1;
-                ignore_delay = true;
+            while (w) {
+                compile_press(w->str, w->len);
+                w = w->next;
             }
 
-            // STRING (-> type each character)
-            else if (inString || compare(cmd->str, cmd->len, "STRING", CASE_SENSETIVE)) {
-                if (inString) {
-                    type(n->str, n->len);
-                } else {
-                    type(line_str, line_str_len);
+            pending = true;
+        }
+
+        if (pending) op_end(!ignore_delay);
+
+        word_list_destroy(wl);
+        arena_reset(&parseArena);
+    }
+
+    // ====== PUBLIC ===== //
+
+    void compile(const char* str, size_t len, EmitFunction emit) {
+        size_t i = 0;
+
+        // All of str is known, so every call uses at least one byte
+        while (i < len) {
+            i += feed(&str[i], len - i, true, emit);
+        }
+    }
+
+    size_t feed(const char* str, size_t len, bool eof, EmitFunction emit) {
+        emitfunc = emit;
+
+        // Find the end of the line
+        size_t line_len = 0;
+
+        while ((line_len < len) && (str[line_len] != '\r') && (str[line_len] != '\n')) ++line_len;
+
+        bool line_end = (line_len < len) || eof;
+
+        // The line break is used too
+        size_t used = (line_len < len) ? line_len + 1 : line_len;
+
+        switch (streamState) {
+            case STREAM_LINE: {
+                if (line_end) {
+                    compile_line(str, line_len);
+                    break;
                 }
 
-                inString = !line_end;
+                // The line continues in the next data, so look at the command first
+                size_t ws = 0; // start index of command
+
+                while ((ws < line_len) && (str[ws] == ' ')) ++ws;
+
+                size_t we = ws; // end index of command
+
+                while ((we < line_len) && (str[we] != ' ')) ++we;
+
+                if (we == line_len) {
+                    // Command isn't complete, wait for more unless it can't fit anyway
+                    if (len < BUFFER_SIZE) return 0;
+                    streamState = STREAM_SKIP;
+                    used        = len;
+                } else if (compare(&str[ws], we - ws, "REM", CASE_SENSETIVE)) {
+                    streamState = STREAM_COMMENT;
+                } else if (compare(&str[ws], we - ws, "STRING", CASE_SENSETIVE)) {
+                    streamState = STREAM_STRING;
+                    used        = we + 1 + compile_string(&str[we + 1], line_len - we - 1, false);
+                } else if (is_command(&str[ws], we - ws)) {
+                    // Wait for the whole line, unless it's too long for that
+                    if (len < BUFFER_SIZE) return 0;
+                    compile_line(str, line_len);
+                    streamState = STREAM_SKIP;
+                } else {
+                    op_begin(OP_HOLD);
+                    streamState = STREAM_KEYS;
+                    used        = compile_keys(str, line_len, false);
+                }
+                break;
             }
 
-            // LED
-            else if (compare(cmd->str, cmd->len, "LED", CASE_SENSETIVE)) {
-                word_node* w = cmd->next;
-
-                int c[3];
+            case STREAM_STRING:
+                if (!line_end) used = compile_string(str, line_len, false);
+                else compile_string(str, line_len, true);
+                break;
 
-                for (uint8_t i = 0; i<3; ++i) {
-                    if (w) {
-                        c[i] = toInt(w->str, w->len);
-                        w    = w->next;
-                    } else {
-                        c[i] = 0;
+            case STREAM_KEYS:
+                if (line_end) {
+                    compile_keys(str, line_len, true);
+                } else {
+                    used = compile_keys(str, line_len, false);
+
+                    // A single word that doesn't fit, press what we have and ignore the rest
+                    if ((used == 0) && (len >= BUFFER_SIZE)) {
+                        op_buf[0] = OP_PRESS;
+                        op_end(true);
+                        streamState = STREAM_SKIP;
+                        used        = len;
                     }
                 }
+                break;
 
-                led::setColor(c[0], c[1], c[2]);
-            }
+            case STREAM_COMMENT:
+            case STREAM_SKIP:
+                break;
+        }
 
-            // KEYCODE
-            else if (compare(cmd->str, cmd->len, "KEYCODE", CASE_SENSETIVE)) {
-                word_node* w = cmd->next;
-                if (w) {
+        if (line_end) streamState = STREAM_LINE;
+
+        emitfunc = NULL;
+
+        return used;
+    }
+
+    void execute(uint8_t code, const uint8_t* data, size_t data_len) {
+        processing    = true;
+        interpretTime = millis();
+
+        switch (code & ~OP_FLAG_DELAY) {
+            case OP_STRING:
+                type((const char*)data, data_len);
+                break;
+
+            case OP_DELAY:
+                sleep(toU32(data, data_len));
+                break;
+
+            case OP_DEFAULTDELAY:
+                defaultDelay = toU32(data, data_len);
+                break;
+
+            case OP_REPEAT:
+                repeatNum = toU32(data, data_len);
+                break;
+
+            case OP_LOCALE:
+                setLocale((const char*)data, data_len);
+                break;
+
+            case OP_OPTIMIZE:
+                if (data_len >= 1) keyboard::setOptimize(data[0]);
+                break;
+
+            case OP_LED:
+                if (data_len >= 3) led::setColor(data[0], data[1], data[2]);
+                break;
+
+            case OP_KEYCODE:
+                if (data_len >= 7) {
                     keyboard::report k;
 
-                    k.modifiers = (uint8_t)toInt(w->str, w->len);
+                    k.modifiers = data[0];
                     k.reserved  = 0;
-                    w           = w->next;
-
-                    for (uint8_t i = 0; i<6; ++i) {
-                        if (w) {
-                            k.keys[i] = (uint8_t)toInt(w->str, w->len);
-                            w         = w->next;
-                        } else {
-                            k.keys[i] = 0;
-                        }
-                    }
+                    memcpy(k.keys, &data[1], 6);
 
                     keyboard::send(&k);
                     keyboard::release();
                 }
-            }
+                break;
 
-            // Otherwise go through words and look for keys to press
-            else {
-                word_node* w = wl->first;
+            case OP_PRESS:
+                press(data, data_len);
+                release();
+                break;
 
-                while (w) {
-                    press(w->str, w->len);
-                    w = w->next;
-                }
+            case OP_HOLD:
+                press(data, data_len);
+                break;
+        }
 
-                if (line_end) release();
-            }
+        if (code & OP_FLAG_DELAY) sleep(defaultDelay);
 
-            n = n->next;
+        processing = false;
+    }
 
-            if (!inString && !inComment && !ignore_delay) sleep(defaultDelay);
+    void parse(const char* str, size_t len) {
+        int repeats = repeatNum;
 
-            if (line_end && (repeatNum > 0)) --repeatNum;
+        compile(str, len, execute);
 
-            interpretTime = millis();
-        }
+        // Every line that isn't a REPEAT itself counts as one repetition
+        if ((repeatNum == repeats) && (repeatNum > 0)) --repeatNum;
+    }
 
-        line_list_destroy(l);
-        processing = false;
+    void reset() {
+        streamState = STREAM_LINE;
+        repeatNum = 0;
+        sleepTime = 0;
+    }
+
+    const arena* getArena() {
+        return &parseArena;
     }
 
     int getRepeats() {
@@ -662,16 +871,21 @@ line_list* parse_lines(const char* str, size_t len) {
     }
 
     unsigned int getDelayTime() {
-        unsigned long finishTime  = sleepStartTime + sleepTime;
-        unsigned long currentTime = millis();
+        unsigned long elapsedTime = millis() - sleepStartTime;
 
-        if (currentTime > finishTime) {
+        if (elapsedTime >= sleepTime) {
+            sleepTime = 0;
             return 0;
         } else {
-            unsigned long remainingTime = finishTime - currentTime;
+            unsigned long remainingTime = sleepTime - elapsedTime;
             return (unsigned int)remainingTime;
         }
     }
+
+    bool isSleeping() {
+        return getDelayTime() > 0;
+    }
+
     bool isProcessing()
     {
         return processing;
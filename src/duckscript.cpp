@@ -5,105 +5,297 @@
 
 #include "duckscript.h"
 #include "duckparser.h"
+#include "duckcompiler.h"
 #include "config.h"
 #include "debug.h"
 
 #include "spiffs.h"
+#include "keyboard.h"
+#include "reader.h"
 
 namespace duckscript
 {
     // ===== PRIVATE ===== //
-    File f;
+    reader::reader_t f;
+    String fileName;
 
-    char * prevMessage    { NULL };
-    size_t prevMessageLen { 0 };
+    bool running{false};
+    bool compiled{false};
 
-    char buf[BUFFER_SIZE];
-    unsigned int buf_i = 0;
+    uint32_t repeatNum   = 0; // Remaining repetitions
+    uint32_t repeatStart = 0; // Start of the repeated code or line
+    uint32_t repeatEnd   = 0; // End of the repeated code or line
+    uint32_t repeatNext  = 0; // Position after the REPEAT
 
-    bool running{false};
+    uint32_t prevStart = 0;     // Start of the last line of the script, for REPEAT
+    uint32_t prevEnd   = 0;     // End of that line
+    uint32_t lineStart = 0;     // Start of the current line
+    bool     newLine   = true;  // Next feed starts a new line
+    bool     blank     = false; // Current line is empty
+    bool     repeated  = false; // Current line is a REPEAT
+    uint32_t line      = 1;     // Line of the plain script that is run
 
-    // ===== PUBLIC ===== //
-    void run(String fileName)
+    void startRepeat(uint32_t num, uint32_t start, uint32_t end)
     {
-        if (fileName.length() > 0)
+        repeatNum   = num;
+        repeatStart = start;
+        repeatEnd   = end;
+        repeatNext  = reader::position(f);
+
+        if ((repeatNum > 0) && (repeatStart < repeatEnd))
         {
-            memset(buf, 0, BUFFER_SIZE);
-            debugf("Run file %s\n", fileName.c_str());
-            f = spiffs::open(fileName);
-            running = true;
-            nextLine();
+            debugln("Repeating last message");
+            --repeatNum;
+            reader::seek(f, repeatStart);
+        }
+        else
+        {
+            repeatStart = repeatEnd = 0;
         }
     }
 
-    void nextLine()
+    // Jump back to the start of the repeated code, or continue after the REPEAT
+    void checkRepeat()
     {
-        if (!running)
+        if ((repeatStart < repeatEnd) && (reader::position(f) >= repeatEnd))
+        {
+            if (repeatNum > 0)
+            {
+                --repeatNum;
+                reader::seek(f, repeatStart);
+            }
+            else
+            {
+                reader::seek(f, repeatNext);
+                repeatStart = repeatEnd = 0;
+            }
+        }
+    }
+
+    void nextCode()
+    {
+        checkRepeat();
+
+        const uint8_t* op = reader::peek(f, OP_HEADER_SIZE);
+
+        if (!op)
+        {
+            debugln("Reached end of file");
+            stopAll();
             return;
+        }
+
+        size_t len = op[1];
+
+        // The whole instruction is in the buffer of the reader
+        op = reader::peek(f, OP_HEADER_SIZE + len);
 
-        if (!f)
+        if (!op)
         {
             debugln("File error");
             stopAll();
             return;
         }
 
-        if (!f.available())
+        f.i += OP_HEADER_SIZE + len;
+
+        if ((op[0] & ~OP_FLAG_DELAY) == OP_REPEAT)
+        {
+            if (len < 12) return;
+
+            uint32_t num, start, end;
+
+            memcpy(&num, &op[2], sizeof(uint32_t));
+            memcpy(&start, &op[6], sizeof(uint32_t));
+            memcpy(&end, &op[10], sizeof(uint32_t));
+
+            startRepeat(num, start, end);
+            return;
+        }
+
+        duckparser::execute(op[0], &op[OP_HEADER_SIZE], len);
+    }
+
+    // REPEAT of a plain script refers to the last line, everything else is run
+    void emit(uint8_t code, const uint8_t* data, size_t len)
+    {
+        if ((code & ~OP_FLAG_DELAY) == OP_REPEAT)
+        {
+            repeatNum = 0;
+            memcpy(&repeatNum, data, _min(len, sizeof(uint32_t)));
+            repeated = true;
+        }
+        else
+        {
+            duckparser::execute(code, data, len);
+        }
+    }
+
+    // Only runs what changes the state of the keyboard, to start in the middle of a script
+    void emitState(uint8_t code, const uint8_t* data, size_t len)
+    {
+        switch (code & ~OP_FLAG_DELAY)
+        {
+            case OP_DEFAULTDELAY:
+            case OP_LOCALE:
+            case OP_OPTIMIZE:
+            case OP_LED:
+                duckparser::execute(code & ~OP_FLAG_DELAY, data, len);
+                break;
+        }
+    }
+
+    void nextText(EmitFunction emit)
+    {
+        checkRepeat();
+
+        if (f.i == f.len)
+            reader::fill(f);
+
+        if (f.i == f.len)
         {
             debugln("Reached end of file");
             stopAll();
             return;
         }
 
-        if (duckparser::getRepeats())
+        if (newLine)
         {
-            repeat();
-            return;
+            lineStart = reader::position(f);
+            blank     = (f.buf[f.i] == '\n') || (f.buf[f.i] == '\r');
+            repeated  = false;
         }
-        buf_i = 0;
-        bool eol = false; // End of line
 
-        while (f.available() && !eol && buf_i < BUFFER_SIZE)
+        size_t n = duckparser::feed(&f.buf[f.i], f.len - f.i, reader::last(f), emit);
+
+        // The line continues after buf
+        if (n == 0)
         {
-            uint8_t b = f.read();
-            eol = (b == '\n');
-            buf[buf_i] = b;
-            ++buf_i;
-            // debug(char(b));
+            reader::fill(f);
+            n = duckparser::feed(&f.buf[f.i], f.len - f.i, reader::last(f), emit);
         }
 
-        if (!eol)
-            debugln();
-        
-        if (strncmp((char*)buf, "REPEAT", _min(buf_i, 6)) != 0 && buf[0] != '\n' && buf[0] != '\r') {
-            if (prevMessage) free(prevMessage);
-            prevMessageLen = buf_i;
-            prevMessage    = (char*)malloc(prevMessageLen + 1);
-            memcpy(prevMessage, buf, buf_i);
-            prevMessage[buf_i] = '\0';
+        f.i    += n;
+        newLine = (n > 0) && ((f.buf[f.i - 1] == '\n') || (f.buf[f.i - 1] == '\r') || ((f.i == f.len) && reader::last(f)));
+
+        if (!newLine)
+            return;
+
+        // Lines that are repeated were counted already
+        if ((f.buf[f.i - 1] == '\n') && (repeatStart >= repeatEnd))
+            ++line;
+
+        if (repeated)
+            startRepeat(repeatNum, prevStart, prevEnd);
+        else if (!blank)
+        {
+            prevStart = lineStart;
+            prevEnd   = reader::position(f);
         }
-        duckparser::parse(buf, buf_i);
     }
 
-    void repeat()
+    // Continues at a line of the script, with the locale and delay set by the lines before it
+    void skipTo(uint32_t target)
     {
-        if (!prevMessage)
+        if (compiled)
         {
-            stopAll();
+            uint32_t offset = duckcompiler::lineOffset(fileName, target);
+
+            if (offset == DUCKC_NO_LINE)
+            {
+                debugf("Line %u doesn't exist\n", target);
+                stopAll();
+                return;
+            }
+
+            while (running && (reader::position(f) < offset))
+            {
+                const uint8_t* op = reader::peek(f, OP_HEADER_SIZE);
+
+                if (!op || !(op = reader::peek(f, OP_HEADER_SIZE + op[1])))
+                    break;
+
+                f.i += OP_HEADER_SIZE + op[1];
+
+                emitState(op[0], &op[OP_HEADER_SIZE], op[1]);
+            }
         }
         else
         {
-            debugln("Repeating last message");
-            duckparser::parse(prevMessage, prevMessageLen);
+            while (running && (line < target))
+                nextText(emitState);
         }
     }
 
+    // ===== PUBLIC ===== //
+    void run(String fileName, uint32_t line)
+    {
+        if (fileName.length() > 0)
+        {
+            debugf("Run file %s\n", fileName.c_str());
+
+            reader::close(f);
+            duckparser::reset();
+            keyboard::resetStats();
+            keyboard::setOptimize(KEYBOARD_OPTIMIZE);
+
+            // Prefer the compiled code, the plain script is the fallback
+            String codeName = duckcompiler::compile(fileName);
+
+            compiled = codeName.length() > 0;
+            reader::begin(f, spiffs::openPooled(compiled ? codeName : fileName));
+
+            if (compiled) reader::seek(f, sizeof(duckcompiler::header_t));
+
+            repeatNum   = 0;
+            repeatStart = repeatEnd = 0;
+            prevStart   = prevEnd = 0;
+            newLine     = true;
+
+            duckscript::line = 1;
+
+            if (!fileName.startsWith("/")) fileName = "/" + fileName;
+            duckscript::fileName = fileName;
+            running = true;
+
+            if (line > 1)
+            {
+                debugf("Start at line %u\n", line);
+                skipTo(line);
+            }
+
+            // The first line is run by loop(), run() can be called from a
+            // callback of the webserver where the keyboard can't wait
+        }
+    }
+
+    void nextLine()
+    {
+        if (!running)
+            return;
+
+        // Wait for the DELAY of the last line, without blocking loop()
+        if (duckparser::isSleeping())
+            return;
+
+        if (!f.file)
+        {
+            debugln("File error");
+            stopAll();
+            return;
+        }
+
+        if (compiled)
+            nextCode();
+        else
+            nextText(emit);
+    }
+
     void stopAll()
     {
         if (running)
         {
-            if (f)
-                f.close();
+            reader::close(f);
             running = false;
             debugln("Stopped script");
         }
@@ -115,9 +307,9 @@ namespace duckscript
             stopAll();
         else
         {
-            if (running && f && (fileName == currentScript()))
+            if (running && f.file && (fileName == currentScript()))
             {
-                f.close();
+                reader::close(f);
                 running = false;
                 debugln("Stopped script");
             }
@@ -129,10 +321,26 @@ namespace duckscript
         return running;
     }
 
+    unsigned int idleTime()
+    {
+        if (!running)
+            return 0;
+        return duckparser::getDelayTime();
+    }
+
+    uint32_t currentLine()
+    {
+        if (!running)
+            return 0;
+        if (compiled)
+            return duckcompiler::lineAt(fileName, reader::position(f));
+        return line;
+    }
+
     String currentScript()
     {
         if (!running)
             return String();
-        return String(f.name());
+        return fileName;
     }
 }
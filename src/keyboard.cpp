@@ -4,10 +4,46 @@
  */
 
 #include "keyboard.h"
+
+#include <coredecls.h> // can_yield
+
+#include "config.h"
+#include "tracer.h"
+
+#define ENCODE_LEN 16 // Bytes of a string that are encoded at once without the cache
+
 namespace keyboard {
     // ====== PRIVATE ====== //
     hid_locale_t* locale      { &locale_us };
 
+    // Reports of a typed string, so typing it again only has to send them
+    typedef struct cache_entry {
+        hid_locale_t* locale;
+        uint32_t      hash;
+        uint32_t      last_used;
+        bool          optimized;
+        size_t        str_len;
+        size_t        reports;
+        uint8_t     * data; // Reports, followed by the string
+    } cache_entry;
+
+    cache_entry cache[KEYBOARD_CACHE_ENTRIES];
+    size_t   cacheBytes { 0 }; // Memory used by all entries
+    uint32_t cacheTime { 0 };  // Incremented for every use, to find the least recently used entry
+
+    bool optimizeReleases { KEYBOARD_OPTIMIZE }; // Leave out releases that aren't needed
+    bool discardReports { false };               // Count reports without sending them, for benchmarks
+
+    // Reports waiting for the UART, update() sends them at the pace of the CH9328
+    report   queue[KEYBOARD_QUEUE_SIZE];
+    size_t   queueStart { 0 };     // Index of the oldest report
+    size_t   queueLen { 0 };       // Reports in the queue
+    size_t   queueHighWater { 0 }; // Most reports that were in the queue at once
+    uint32_t queueSent { 0 };      // Reports sent since the last resetStats()
+    uint32_t queueBusyTime { 0 };  // Time in us the queue wasn't empty, since the last resetStats()
+    uint32_t queueTime { 0 };      // micros() of the last update()
+    uint32_t queueCredit { 0 };    // Time in us that can be spent on sending reports
+
     report prev_report = report { KEY_NONE, KEY_NONE, { KEY_NONE, KEY_NONE, KEY_NONE, KEY_NONE, KEY_NONE, KEY_NONE } };
 
     report makeReport(uint8_t modifiers = 0, uint8_t key1 = 0, uint8_t key2 = 0, uint8_t key3 = 0, uint8_t key4 = 0, uint8_t key5 = 0, uint8_t key6 = 0);
@@ -29,6 +65,298 @@ namespace keyboard {
         return k;
     }
 
+    bool isReleased() {
+        report empty = makeReport();
+
+        return memcmp(&prev_report, &empty, sizeof(report)) == 0;
+    }
+
+    // Decodes the utf8 character at b, returns its length or 0 if it's not valid utf8
+    uint8_t decodeUTF8(const uint8_t* b, size_t len, uint32_t* codepoint) {
+        uint8_t  n;
+        uint32_t c;
+
+        if ((b[0] & 0xE0) == 0xC0) {
+            n = 2;
+            c = b[0] & 0x1F;
+        } else if ((b[0] & 0xF0) == 0xE0) {
+            n = 3;
+            c = b[0] & 0x0F;
+        } else if ((b[0] & 0xF8) == 0xF0) {
+            n = 4;
+            c = b[0] & 0x07;
+        } else {
+            return 0;
+        }
+
+        if (n > len) return 0;
+
+        for (uint8_t i = 1; i < n; ++i) {
+            if ((b[i] & 0xC0) != 0x80) return 0;
+            c = (c << 6) | (b[i] & 0x3F);
+        }
+
+        *codepoint = c;
+
+        return n;
+    }
+
+    // Unpacks a character of a locale table
+    void unpack(uint8_t c, uint8_t* modifiers, uint8_t* key) {
+        *modifiers = ((c & LOCALE_SHIFT) ? KEY_MOD_LSHIFT : 0) | ((c & LOCALE_ALTGR) ? KEY_MOD_RALT : 0);
+        *key       = locale->keys[c & LOCALE_KEY_MASK];
+    }
+
+    // Finds modifiers and key of the character at b in the current locale
+    // Returns the number of bytes the character takes, or 0 if the locale doesn't have it
+    uint8_t lookup(const uint8_t* b, size_t len, uint8_t* modifiers, uint8_t* key) {
+        // ASCII
+        if (b[0] < locale->ascii_len) {
+            unpack(pgm_read_byte(locale->ascii + b[0]), modifiers, key);
+
+            return 1;
+        }
+
+        // UTF8, binary search of the codepoint
+        uint32_t codepoint;
+        uint8_t  used = decodeUTF8(b, len, &codepoint);
+
+        if (used > 0) {
+            size_t lo = 0;
+            size_t hi = locale->utf8_len;
+
+            while (lo < hi) {
+                size_t   mid   = (lo + hi) / 2;
+                uint32_t entry = pgm_read_dword(&locale->utf8[mid]);
+                uint32_t c     = entry & 0xFFFFFF;
+
+                if (c < codepoint) {
+                    lo = mid + 1;
+                } else if (c > codepoint) {
+                    hi = mid;
+                } else {
+                    unpack(entry >> 24, modifiers, key);
+
+                    return used;
+                }
+            }
+        }
+
+        // Extended ASCII, binary search of the code
+        size_t lo = 0;
+        size_t hi = locale->extended_ascii_len;
+
+        while (lo < hi) {
+            size_t   mid   = (lo + hi) / 2;
+            uint16_t entry = pgm_read_word(&locale->extended_ascii[mid]);
+            uint8_t  c     = entry & 0xFF;
+
+            if (c < b[0]) {
+                lo = mid + 1;
+            } else if (c > b[0]) {
+                hi = mid;
+            } else {
+                unpack(entry >> 8, modifiers, key);
+
+                return 1;
+            }
+        }
+
+        return 0;
+    }
+
+    // Where encode() stopped, so a string can be encoded in parts
+    typedef struct encode_state {
+        report last; // Last press
+        bool   held; // Last report is a press
+    } encode_state;
+
+    // Writes the reports for typing str on a released keyboard to out
+    // A character gets a press and a release report, unknown characters only the release
+    // Optimized, a press of a different key with the same modifiers replaces the last key
+    // without a release in between, and unknown characters don't add releases
+    // state continues where the previous part stopped, a press that's still held
+    // at the end is only released when finish is set
+    // Returns the number of reports, out can be NULL to only count them
+    size_t encode(const char* str, size_t len, report* out, bool optimized, encode_state& state, bool finish) {
+        size_t  n    = 0;
+        report& last = state.last;
+        bool  & held = state.held;
+
+        for (size_t i = 0; i<len; ++i) {
+            uint8_t modifiers;
+            uint8_t key;
+            uint8_t used = lookup((const uint8_t*)&str[i], len - i, &modifiers, &key);
+
+            if (used > 0) {
+                report k = makeReport(modifiers, key);
+
+                if (held && (!optimized || (k.modifiers != last.modifiers) || (k.keys[0] == last.keys[0]))) {
+                    if (out) out[n] = makeReport();
+                    ++n;
+                }
+
+                if (out) out[n] = k;
+                ++n;
+
+                last = k;
+                held = true;
+                i   += used - 1;
+            }
+
+            if (!optimized || (held && (used == 0))) {
+                if (out) out[n] = makeReport();
+                ++n;
+                held = false;
+            }
+        }
+
+        if (finish && held) {
+            if (out) out[n] = makeReport();
+            ++n;
+            held = false;
+        }
+
+        return n;
+    }
+
+    size_t encode(const char* str, size_t len, report* out, bool optimized) {
+        encode_state state { makeReport(), false };
+
+        return encode(str, len, out, optimized, state, true);
+    }
+
+    // ===== Queue ===== //
+    // yield() keeps WiFi and the webserver running while the UART is busy,
+    // but it panics in the callbacks of the webserver (SYS context).
+    // There the queue is only drained by calling update() again and again.
+    void wait() {
+        if (can_yield()) yield();
+    }
+
+    void push(const report* k) {
+        if (discardReports) {
+            ++queueSent;
+            return;
+        }
+
+        // Wait for space
+        while (queueLen == KEYBOARD_QUEUE_SIZE) {
+            update();
+            if (queueLen == KEYBOARD_QUEUE_SIZE) wait();
+        }
+
+        queue[(queueStart + queueLen) % KEYBOARD_QUEUE_SIZE] = *k;
+        ++queueLen;
+
+        if (queueLen > queueHighWater) queueHighWater = queueLen;
+    }
+
+    // Types a string on a released keyboard, in parts that fit on the stack
+    // A press can be held from one part into the next, so the keyboard is only released once
+    void writeEncoded(const char* str, size_t len) {
+        report reports[ENCODE_LEN * 2 + 1];
+        encode_state state { makeReport(), false };
+        size_t i = 0;
+
+        while (i < len) {
+            size_t part = _min(len - i, ENCODE_LEN);
+
+            // Don't split utf8 characters
+            while ((i + part < len) && (part > 1) && (((uint8_t)str[i + part] & 0xC0) == 0x80)) --part;
+
+            size_t n = encode(&str[i], part, reports, optimizeReleases, state, i + part == len);
+
+            for (size_t j = 0; j<n; ++j) push(&reports[j]);
+
+            i += part;
+        }
+
+        prev_report = makeReport();
+    }
+
+    // ===== Report cache ===== //
+    uint32_t hash(const char* str, size_t len) {
+        // FNV-1a
+        uint32_t h = 2166136261UL;
+
+        for (size_t i = 0; i<len; ++i) {
+            h ^= (uint8_t)str[i];
+            h *= 16777619UL;
+        }
+
+        return h;
+    }
+
+    void cacheRemove(cache_entry* e) {
+        if (e->data) {
+            free(e->data);
+            cacheBytes -= e->reports * sizeof(report) + e->str_len;
+        }
+
+        e->data = NULL;
+    }
+
+    cache_entry* cacheGet(const char* str, size_t len, uint32_t h) {
+        for (size_t i = 0; i<KEYBOARD_CACHE_ENTRIES; ++i) {
+            cache_entry* e = &cache[i];
+
+            // Compare the string too, a hash collision must not type something else
+            if (e->data && (e->locale == locale) && (e->optimized == optimizeReleases) &&
+                (e->hash == h) && (e->str_len == len) &&
+                (memcmp(&e->data[e->reports * sizeof(report)], str, len) == 0)) {
+                e->last_used = ++cacheTime;
+                return e;
+            }
+        }
+
+        return NULL;
+    }
+
+    cache_entry* cachePut(const char* str, size_t len, uint32_t h) {
+        size_t reports = encode(str, len, NULL, optimizeReleases);
+        size_t size    = reports * sizeof(report) + len;
+
+        if (size > KEYBOARD_CACHE_SIZE) return NULL;
+
+        // Make room by removing the least recently used entries
+        for (;;) {
+            cache_entry* lru  = NULL;
+            cache_entry* empty = NULL;
+
+            for (size_t i = 0; i<KEYBOARD_CACHE_ENTRIES; ++i) {
+                cache_entry* e = &cache[i];
+
+                if (!e->data) empty = e;
+                else if (!lru || (e->last_used < lru->last_used)) lru = e;
+            }
+
+            if (empty && (cacheBytes + size <= KEYBOARD_CACHE_SIZE)) {
+                uint8_t* data = (uint8_t*)malloc(size);
+
+                if (!data) return NULL;
+
+                encode(str, len, (report*)data, optimizeReleases);
+                memcpy(&data[reports * sizeof(report)], str, len);
+
+                empty->locale    = locale;
+                empty->hash      = h;
+                empty->last_used = ++cacheTime;
+                empty->optimized = optimizeReleases;
+                empty->str_len   = len;
+                empty->reports   = reports;
+                empty->data      = data;
+
+                cacheBytes += size;
+
+                return empty;
+            }
+
+            if (!lru) return NULL;
+            cacheRemove(lru);
+        }
+    }
+
     // ====== PUBLIC ====== //
 
     uint8_t pinrst = 10;
@@ -51,8 +379,48 @@ namespace keyboard {
         keyboard::locale = locale;
     }
 
+    hid_locale_t* getLocale() {
+        return locale;
+    }
+
     void send(report* k) {
-        Serial.write((uint8_t*)k, sizeof(report));
+        push(k);
+    }
+
+    void update() {
+        uint32_t now     = micros();
+        uint32_t elapsed = now - queueTime;
+
+        queueTime = now;
+
+        // An idle UART can take the next report right away
+        if (queueLen == 0) {
+            queueCredit = KEYBOARD_REPORT_TIME;
+            return;
+        }
+
+        queueBusyTime += elapsed;
+
+        // Only as many reports as the CH9328 can take in the time since the last update
+        queueCredit = _min(queueCredit + elapsed, (uint32_t)KEYBOARD_QUEUE_SIZE * KEYBOARD_REPORT_TIME);
+
+        while (queueLen > 0 && queueCredit >= KEYBOARD_REPORT_TIME &&
+               (size_t)Serial.availableForWrite() >= sizeof(report)) {
+            Serial.write((uint8_t*)&queue[queueStart], sizeof(report));
+            tracer::record((uint8_t*)&queue[queueStart]);
+
+            queueStart   = (queueStart + 1) % KEYBOARD_QUEUE_SIZE;
+            queueCredit -= KEYBOARD_REPORT_TIME;
+            --queueLen;
+            ++queueSent;
+        }
+    }
+
+    void flush() {
+        while (queueLen > 0) {
+            update();
+            if (queueLen > 0) wait();
+        }
     }
 
     void release() {
@@ -77,80 +445,92 @@ namespace keyboard {
         send(&prev_report);
     }
 
-    uint8_t press(const char* strPtr) {
-        // Convert string pointer into a byte pointer
-        uint8_t* b = (uint8_t*)strPtr;
-        
-        // ASCII
-        if (b[0] < locale->ascii_len) {
-            uint8_t modifiers = pgm_read_byte(locale->ascii + (b[0] * 2) + 0);
-            uint8_t key       = pgm_read_byte(locale->ascii + (b[0] * 2) + 1);
+    uint8_t press(const char* strPtr, size_t len) {
+        uint8_t modifiers;
+        uint8_t key;
+        uint8_t used = lookup((const uint8_t*)strPtr, len, &modifiers, &key);
 
-            pressKey(key, modifiers);
+        if (used == 0) return 0;
 
-            return 0;
-        }
-        
-        // UTF8
-        for (size_t i = 0; i<locale->utf8_len; ++i) {
-            uint8_t res = 0;
-
-            // Read utf8 code and match it with the given data
-            for (uint8_t j = 0; j<4; ++j) {
-                uint8_t key_code = pgm_read_byte(locale->utf8 + (i * 6) + j);
+        pressKey(key, modifiers);
 
-                if (key_code == 0) {
-                    break;
-                }
+        // Return the number of extra bytes we used from the string pointer
+        return used - 1;
+    }
 
-                if (key_code == b[j]) {
-                    ++res;
-                } else {
-                    res = 0;
-                    break;
-                }
-            }
+    uint8_t write(const char* c) {
+        uint8_t res = press(c);
 
-            // If a match was found, read out the data and type it
-            if (res > 0) {
-                uint8_t modifiers = pgm_read_byte(locale->utf8 + (i * 6) + 4);
-                uint8_t key       = pgm_read_byte(locale->utf8 + (i * 6) + 5);
+        release();
 
-                pressKey(key, modifiers);
+        return res;
+    }
 
-                // Return the number of extra bytes we used from the string pointer
-                return res-1;
+    void write(const char* str, size_t len) {
+        // Held keys would be part of the first report, so only a released keyboard can be encoded
+        if (!isReleased()) {
+            for (size_t i = 0; i<len; ++i) {
+                i += press(&str[i], len - i);
+                release();
             }
+            return;
         }
 
-        // Extended ASCII
-        for (uint8_t i = 0; i<locale->extended_ascii_len; ++i) {
-            uint8_t key_code = pgm_read_byte(locale->extended_ascii + (i * 3));
+        if (len >= KEYBOARD_CACHE_MIN_LEN) {
+            uint32_t     h = hash(str, len);
+            cache_entry* e = cacheGet(str, len, h);
 
-            if (b[0] == key_code) {
-                uint8_t modifiers = pgm_read_byte(locale->extended_ascii + (i * 3) + 1);
-                uint8_t key       = pgm_read_byte(locale->extended_ascii + (i * 3) + 2);
+            if (!e) e = cachePut(str, len, h);
 
-                pressKey(key, modifiers);
+            if (e) {
+                const report* reports = (const report*)e->data;
 
-                return 0;
+                for (size_t i = 0; i<e->reports; ++i) push(&reports[i]);
+
+                prev_report = makeReport();
+                return;
             }
         }
 
-        return 0;
+        writeEncoded(str, len);
     }
 
-    uint8_t write(const char* c) {
-        uint8_t res = press(c);
+    void setOptimize(bool optimize) {
+        optimizeReleases = optimize;
+    }
 
-        release();
+    void setDiscard(bool discard) {
+        discardReports = discard;
+    }
 
-        return res;
+    size_t queued() {
+        return queueLen;
     }
 
-    void write(const char* str, size_t len) {
-        for (size_t i = 0; i<len; ++i) {
-            i += write(&str[i]);
-        }
+    size_t getHighWater() {
+        return queueHighWater;
+    }
+
+    uint32_t getSent() {
+        return queueSent;
+    }
+
+    uint32_t getReportsPerSecond() {
+        if (queueBusyTime == 0) return 0;
+        return (uint32_t)((uint64_t)queueSent * 1000000 / queueBusyTime);
+    }
+
+    unsigned int getPendingTime() {
+        return (queueLen * KEYBOARD_REPORT_TIME + 999) / 1000;
+    }
+
+    void resetStats() {
+        queueHighWater = queueLen;
+        queueSent      = 0;
+        queueBusyTime  = 0;
+    }
+
+    void clearCache() {
+        for (size_t i = 0; i<KEYBOARD_CACHE_ENTRIES; ++i) cacheRemove(&cache[i]);
     }
 }
@@ -20,15 +20,30 @@ namespace keyboard {
     void begin();
 
     void setLocale(hid_locale_t* locale);
+    hid_locale_t* getLocale();
 
     void send(report* k);
+    void update();
+    void flush();
     void release();
 
     void pressKey(uint8_t key, uint8_t modifiers = KEY_NONE);
     void pressModifier(uint8_t key);
 
-    uint8_t press(const char* strPtr);
+    // At most len bytes of strPtr are read, a zero terminated character can leave it out
+    uint8_t press(const char* strPtr, size_t len = 4);
 
     uint8_t write(const char* c);
     void write(const char* str, size_t len);
+    void setOptimize(bool optimize);
+    void setDiscard(bool discard);
+
+    size_t queued();
+    size_t getHighWater();
+    uint32_t getSent();
+    uint32_t getReportsPerSecond();
+    unsigned int getPendingTime();
+    void resetStats();
+
+    void clearCache();
 }
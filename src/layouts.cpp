@@ -0,0 +1,197 @@
+/*
+   This software is licensed under the MIT License. See the license file for details.
+   Source: https://github.com/spacehuhntech/WiFiDuck
+ */
+
+#include "layouts.h"
+
+#include "config.h"
+#include "debug.h"
+
+#include "keyboard.h"
+#include "spiffs.h"
+
+namespace layouts {
+    // ===== PRIVATE ===== //
+
+    // A layout loaded from SPIFFS, the tables are in one block of memory
+    typedef struct layout_t {
+        hid_locale_t locale;
+        char         name[LAYOUT_NAME_LEN + 1];
+        uint32_t     last_used;
+        uint8_t    * data;
+    } layout_t;
+
+    layout_t cache[KEYBOARD_LAYOUT_CACHE];
+    uint32_t cacheTime { 0 }; // Incremented for every use, to find the least recently used layout
+
+    bool equals(const char* a, const char* b, size_t len) {
+        for (size_t i = 0; i < len; ++i) {
+            if (toupper(a[i]) != toupper(b[i])) return false;
+        }
+        return b[len] == '\0';
+    }
+
+    // Names of loaded layouts are file names, which are case sensitive in LittleFS
+    bool sameName(const char* a, const char* b, size_t len) {
+        return (strncmp(a, b, len) == 0) && (b[len] == '\0');
+    }
+
+    // Every packed character has to point into the keys of its layout
+    bool validKeys(const uint8_t* packed, size_t len, size_t step, uint8_t keysLen) {
+        for (size_t i = 0; i < len; i += step) {
+            if ((packed[i] & LOCALE_KEY_MASK) >= keysLen) return false;
+        }
+        return true;
+    }
+
+    void remove(layout_t* l) {
+        if (!l->data) return;
+
+        free(l->data);
+        l->data    = NULL;
+        l->name[0] = '\0';
+
+        // The reports of the keyboard cache belong to the address of the layout
+        keyboard::clearCache();
+    }
+
+    // Removes a layout that might be the one being typed with
+    void release(layout_t* l) {
+        if (&l->locale == keyboard::getLocale()) keyboard::setLocale(&locale_us);
+        remove(l);
+    }
+
+    // Least recently used slot that isn't the layout being typed with
+    layout_t* slot() {
+        layout_t* l = NULL;
+
+        for (size_t i = 0; i < KEYBOARD_LAYOUT_CACHE; ++i) {
+            if (!cache[i].data) return &cache[i];
+
+            if ((&cache[i].locale != keyboard::getLocale()) && (!l || (cache[i].last_used < l->last_used))) {
+                l = &cache[i];
+            }
+        }
+
+        if (l) remove(l);
+
+        return l;
+    }
+
+    hid_locale_t* load(const char* name, size_t len) {
+        String fileName = "/";
+
+        for (size_t i = 0; i < len; ++i) fileName += name[i];
+        fileName += LAYOUT_EXTENSION;
+
+        if (!spiffs::exists(fileName)) return NULL;
+
+        File f = spiffs::openRead(fileName);
+
+        header_t h;
+
+        if (!f || (f.read((uint8_t*)&h, sizeof(header_t)) != sizeof(header_t)) ||
+            (memcmp(h.magic, LAYOUT_MAGIC, sizeof(h.magic)) != 0) || (h.version != LAYOUT_VERSION) ||
+            (h.keys_len > LOCALE_KEY_MASK + 1)) {
+            debugf("Invalid layout %s\n", fileName.c_str());
+            return NULL;
+        }
+
+        // utf8 first, so every table is aligned
+        size_t utf8_size  = h.utf8_len * sizeof(uint32_t);
+        size_t ext_size   = h.extended_ascii_len * sizeof(uint16_t);
+        size_t table_size = utf8_size + ext_size + 128 + h.keys_len;
+
+        if (f.size() != sizeof(header_t) + table_size) {
+            debugf("Invalid layout %s\n", fileName.c_str());
+            return NULL;
+        }
+
+        layout_t* l = slot();
+
+        if (!l) return NULL;
+
+        l->data = (uint8_t*)malloc(table_size);
+
+        if (!l->data) return NULL;
+
+        uint8_t* utf8  = l->data;
+        uint8_t* ext   = utf8 + utf8_size;
+        uint8_t* ascii = ext + ext_size;
+        uint8_t* keys  = ascii + 128;
+
+        // Same order as in the file
+        bool ok = (f.read(keys, h.keys_len) == h.keys_len) &&
+                  (f.read(ascii, 128) == 128) &&
+                  (f.read(ext, ext_size) == ext_size) &&
+                  (f.read(utf8, utf8_size) == utf8_size);
+
+        // The packed character is the high byte of a little endian table entry
+        ok = ok && validKeys(ascii, 128, 1, h.keys_len) &&
+             validKeys(ext + 1, ext_size, sizeof(uint16_t), h.keys_len) &&
+             validKeys(utf8 + 3, utf8_size, sizeof(uint32_t), h.keys_len);
+
+        if (!ok) {
+            debugf("Invalid layout %s\n", fileName.c_str());
+            free(l->data);
+            l->data = NULL;
+            return NULL;
+        }
+
+        memcpy(l->name, name, len);
+        l->name[len] = '\0';
+
+        l->locale.name               = l->name;
+        l->locale.keys               = keys;
+        l->locale.ascii              = ascii;
+        l->locale.ascii_len          = 128;
+        l->locale.extended_ascii     = (const uint16_t*)ext;
+        l->locale.extended_ascii_len = h.extended_ascii_len;
+        l->locale.utf8               = (const uint32_t*)utf8;
+        l->locale.utf8_len           = h.utf8_len;
+        l->last_used                 = ++cacheTime;
+
+        debugf("Loaded layout %s (%u bytes)\n", fileName.c_str(), (unsigned int)table_size);
+
+        return &l->locale;
+    }
+
+    // ===== PUBLIC ===== //
+    hid_locale_t* get(const char* name, size_t len) {
+        if (!name || (len == 0) || (len > LAYOUT_NAME_LEN)) return NULL;
+
+        // Compiled in
+        for (size_t i = 0; i < LOCALES_LEN; ++i) {
+            if (equals(name, locales[i]->name, len)) return locales[i];
+        }
+
+        // Loaded before
+        for (size_t i = 0; i < KEYBOARD_LAYOUT_CACHE; ++i) {
+            if (cache[i].data && sameName(name, cache[i].name, len)) {
+                cache[i].last_used = ++cacheTime;
+                return &cache[i].locale;
+            }
+        }
+
+        return load(name, len);
+    }
+
+    // Drops the layout of a file that was changed, so the next LOCALE loads it again
+    void invalidate(String fileName) {
+        if (!fileName.endsWith(LAYOUT_EXTENSION)) return;
+
+        int start = fileName.startsWith("/") ? 1 : 0;
+        int end   = fileName.length() - strlen(LAYOUT_EXTENSION);
+
+        for (size_t i = 0; i < KEYBOARD_LAYOUT_CACHE; ++i) {
+            if (cache[i].data && sameName(fileName.c_str() + start, cache[i].name, end - start)) {
+                release(&cache[i]);
+            }
+        }
+    }
+
+    void clearCache() {
+        for (size_t i = 0; i < KEYBOARD_LAYOUT_CACHE; ++i) release(&cache[i]);
+    }
+}
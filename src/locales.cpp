@@ -0,0 +1,476 @@
+/*
+   This software is licensed under the MIT License. See the license file for details.
+   Source: https://github.com/spacehuhntech/WiFiDuck
+ */
+
+// Generated by scripts/locales.py from scripts/layouts.txt, do not edit!
+
+#include "locales/locales.h"
+
+// Kept in RAM, it's read for every character
+const uint8_t locale_keys[LOCALE_KEYS_LEN] = {
+    KEY_NONE,         KEY_A,            KEY_B,            KEY_C,
+    KEY_D,            KEY_E,            KEY_F,            KEY_G,
+    KEY_H,            KEY_I,            KEY_J,            KEY_K,
+    KEY_L,            KEY_M,            KEY_N,            KEY_O,
+    KEY_P,            KEY_Q,            KEY_R,            KEY_S,
+    KEY_T,            KEY_U,            KEY_V,            KEY_W,
+    KEY_X,            KEY_Y,            KEY_Z,            KEY_1,
+    KEY_2,            KEY_3,            KEY_4,            KEY_5,
+    KEY_6,            KEY_7,            KEY_8,            KEY_9,
+    KEY_0,            KEY_ENTER,        KEY_BACKSPACE,    KEY_TAB,
+    KEY_SPACE,        KEY_MINUS,        KEY_EQUAL,        KEY_LEFTBRACE,
+    KEY_RIGHTBRACE,   KEY_BACKSLASH,    KEY_HASHTILDE,    KEY_SEMICOLON,
+    KEY_APOSTROPHE,   KEY_GRAVE,        KEY_COMMA,        KEY_DOT,
+    KEY_SLASH,        KEY_102ND,
+};
+
+// ===== US ===== //
+const uint8_t ascii_us[128] PROGMEM = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 0x00
+    0x26, 0x27, 0x25, 0x00, 0x00, 0x00, 0x00, 0x00, // 0x08
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 0x10
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 0x18
+    0x28, 0x5B, 0x70, 0x5D, 0x5E, 0x5F, 0x61, 0x30, // 0x20 ! " # $ % & '
+    0x63, 0x64, 0x62, 0x6A, 0x32, 0x29, 0x33, 0x34, // 0x28 ( ) * + , - . /
+    0x24, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0x20, 0x21, // 0x30 0 1 2 3 4 5 6 7
+    0x22, 0x23, 0x6F, 0x2F, 0x72, 0x2A, 0x73, 0x74, // 0x38 8 9 : ; < = > ?
+    0x5C, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47, // 0x40 @ A B C D E F G
+    0x48, 0x49, 0x4A, 0x4B, 0x4C, 0x4D, 0x4E, 0x4F, // 0x48 H I J K L M N O
+    0x50, 0x51, 0x52, 0x53, 0x54, 0x55, 0x56, 0x57, // 0x50 P Q R S T U V W
+    0x58, 0x59, 0x5A, 0x2B, 0x2D, 0x2C, 0x60, 0x69, // 0x58 X Y Z [ \ ] ^ _
+    0x31, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, // 0x60 ` a b c d e f g
+    0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, // 0x68 h i j k l m n o
+    0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, // 0x70 p q r s t u v w
+    0x18, 0x19, 0x1A, 0x6B, 0x6D, 0x6C, 0x71, 0x00, // 0x78 x y z { | } ~
+};
+
+hid_locale_t locale_us {
+    "US",
+    locale_keys,
+    ascii_us, 128,
+    NULL, 0,
+    NULL, 0
+};
+
+// ===== DE ===== //
+const uint8_t ascii_de[128] PROGMEM = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 0x00
+    0x26, 0x27, 0x25, 0x00, 0x00, 0x00, 0x00, 0x00, // 0x08
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 0x10
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 0x18
+    0x28, 0x5B, 0x5C, 0x2D, 0x5E, 0x5F, 0x60, 0x6D, // 0x20 ! " # $ % & '
+    0x62, 0x63, 0x6C, 0x2C, 0x32, 0x34, 0x33, 0x61, // 0x28 ( ) * + , - . /
+    0x24, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0x20, 0x21, // 0x30 0 1 2 3 4 5 6 7
+    0x22, 0x23, 0x73, 0x72, 0x35, 0x64, 0x75, 0x69, // 0x38 8 9 : ; < = > ?
+    0x91, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47, // 0x40 @ A B C D E F G
+    0x48, 0x49, 0x4A, 0x4B, 0x4C, 0x4D, 0x4E, 0x4F, // 0x48 H I J K L M N O
+    0x50, 0x51, 0x52, 0x53, 0x54, 0x55, 0x56, 0x57, // 0x50 P Q R S T U V W
+    0x58, 0x5A, 0x59, 0xA2, 0xA9, 0xA3, 0x31, 0x74, // 0x58 X Y Z [ \ ] ^ _
+    0x6A, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, // 0x60 ` a b c d e f g
+    0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, // 0x68 h i j k l m n o
+    0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, // 0x70 p q r s t u v w
+    0x18, 0x1A, 0x19, 0xA1, 0xB5, 0xA4, 0xAC, 0x26, // 0x78 x y z { | } ~
+};
+
+// Packed character << 8 | code
+const uint16_t extended_ascii_de[] PROGMEM = {
+    0x2B81, // ü
+    0x3084, // ä
+    0x708E, // Ä
+    0x2F94, // ö
+    0x6F99, // Ö
+    0x6B9A, // Ü
+    0x29E1, // ß
+    0x71F8, // °
+    0x9CFD, // ²
+};
+
+// Packed character << 24 | codepoint
+const uint32_t utf8_de[] PROGMEM = {
+    0x5D0000A7, // §
+    0x710000B0, // °
+    0x9C0000B2, // ²
+    0x9D0000B3, // ³
+    0x700000C4, // Ä
+    0x6F0000D6, // Ö
+    0x6B0000DC, // Ü
+    0x290000DF, // ß
+    0x300000E4, // ä
+    0x2F0000F6, // ö
+    0x2B0000FC, // ü
+    0x850020AC, // €
+};
+
+hid_locale_t locale_de {
+    "DE",
+    locale_keys,
+    ascii_de, 128,
+    extended_ascii_de, sizeof(extended_ascii_de) / sizeof(uint16_t),
+    utf8_de, sizeof(utf8_de) / sizeof(uint32_t)
+};
+
+// ===== GB ===== //
+const uint8_t ascii_gb[128] PROGMEM = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 0x00
+    0x26, 0x27, 0x25, 0x00, 0x00, 0x00, 0x00, 0x00, // 0x08
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 0x10
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 0x18
+    0x28, 0x5B, 0x5C, 0x2E, 0x5E, 0x5F, 0x61, 0x30, // 0x20 ! " # $ % & '
+    0x63, 0x64, 0x62, 0x6A, 0x32, 0x29, 0x33, 0x34, // 0x28 ( ) * + , - . /
+    0x24, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0x20, 0x21, // 0x30 0 1 2 3 4 5 6 7
+    0x22, 0x23, 0x6F, 0x2F, 0x72, 0x2A, 0x73, 0x74, // 0x38 8 9 : ; < = > ?
+    0x70, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47, // 0x40 @ A B C D E F G
+    0x48, 0x49, 0x4A, 0x4B, 0x4C, 0x4D, 0x4E, 0x4F, // 0x48 H I J K L M N O
+    0x50, 0x51, 0x52, 0x53, 0x54, 0x55, 0x56, 0x57, // 0x50 P Q R S T U V W
+    0x58, 0x59, 0x5A, 0x2B, 0x2D, 0x2C, 0x60, 0x69, // 0x58 X Y Z [ \ ] ^ _
+    0x31, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, // 0x60 ` a b c d e f g
+    0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, // 0x68 h i j k l m n o
+    0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, // 0x70 p q r s t u v w
+    0x18, 0x19, 0x1A, 0x6B, 0x6D, 0x6C, 0x6E, 0x00, // 0x78 x y z { | } ~
+};
+
+// Packed character << 8 | code
+const uint16_t extended_ascii_gb[] PROGMEM = {
+    0x8582, // é
+    0xC590, // É
+    0x5D9C, // £
+    0x89A1, // í
+    0x8FA2, // ó
+    0x95A3, // ú
+    0xB1A6, // ¦
+    0x71AA, // ¬
+};
+
+// Packed character << 24 | codepoint
+const uint32_t utf8_gb[] PROGMEM = {
+    0x5D0000A3, // £
+    0xB10000A6, // ¦
+    0x710000AC, // ¬
+    0xC50000C9, // É
+    0xC90000CD, // Í
+    0xCF0000D3, // Ó
+    0xD50000DA, // Ú
+    0x850000E9, // é
+    0x890000ED, // í
+    0x8F0000F3, // ó
+    0x950000FA, // ú
+    0x9E0020AC, // €
+};
+
+hid_locale_t locale_gb {
+    "GB",
+    locale_keys,
+    ascii_gb, 128,
+    extended_ascii_gb, sizeof(extended_ascii_gb) / sizeof(uint16_t),
+    utf8_gb, sizeof(utf8_gb) / sizeof(uint32_t)
+};
+
+// ===== ES ===== //
+const uint8_t ascii_es[128] PROGMEM = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 0x00
+    0x26, 0x27, 0x25, 0x00, 0x00, 0x00, 0x00, 0x00, // 0x08
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 0x10
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 0x18
+    0x28, 0x5B, 0x5C, 0x9D, 0x5E, 0x5F, 0x60, 0x29, // 0x20 ! " # $ % & '
+    0x62, 0x63, 0x6C, 0x2C, 0x32, 0x34, 0x33, 0x61, // 0x28 ( ) * + , - . /
+    0x24, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0x20, 0x21, // 0x30 0 1 2 3 4 5 6 7
+    0x22, 0x23, 0x73, 0x72, 0x35, 0x64, 0x75, 0x69, // 0x38 8 9 : ; < = > ?
+    0x9C, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47, // 0x40 @ A B C D E F G
+    0x48, 0x49, 0x4A, 0x4B, 0x4C, 0x4D, 0x4E, 0x4F, // 0x48 H I J K L M N O
+    0x50, 0x51, 0x52, 0x53, 0x54, 0x55, 0x56, 0x57, // 0x50 P Q R S T U V W
+    0x58, 0x59, 0x5A, 0xAB, 0xB1, 0xAC, 0x6B, 0x74, // 0x58 X Y Z [ \ ] ^ _
+    0x2B, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, // 0x60 ` a b c d e f g
+    0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, // 0x68 h i j k l m n o
+    0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, // 0x70 p q r s t u v w
+    0x18, 0x19, 0x1A, 0xB0, 0x9B, 0xAD, 0x9E, 0x00, // 0x78 x y z { | } ~
+};
+
+// Packed character << 8 | code
+const uint16_t extended_ascii_es[] PROGMEM = {
+    0x6D80, // Ç
+    0x2D87, // ç
+    0x2FA4, // ñ
+    0x6FA5, // Ñ
+    0x71A6, // ª
+    0x31A7, // º
+    0x6AA8, // ¿
+    0x2AAD, // ¡
+    0x30EF, // ´
+    0x70F9, // ¨
+    0x5DFA, // ·
+};
+
+// Packed character << 24 | codepoint
+const uint32_t utf8_es[] PROGMEM = {
+    0x2A0000A1, // ¡
+    0x700000A8, // ¨
+    0x710000AA, // ª
+    0x300000B4, // ´
+    0x5D0000B7, // ·
+    0x310000BA, // º
+    0x6A0000BF, // ¿
+    0x6D0000C7, // Ç
+    0x6F0000D1, // Ñ
+    0x2D0000E7, // ç
+    0x2F0000F1, // ñ
+    0x850020AC, // €
+};
+
+hid_locale_t locale_es {
+    "ES",
+    locale_keys,
+    ascii_es, 128,
+    extended_ascii_es, sizeof(extended_ascii_es) / sizeof(uint16_t),
+    utf8_es, sizeof(utf8_es) / sizeof(uint32_t)
+};
+
+// ===== FR ===== //
+const uint8_t ascii_fr[128] PROGMEM = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 0x00
+    0x26, 0x27, 0x25, 0x00, 0x00, 0x00, 0x00, 0x00, // 0x08
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 0x10
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 0x18
+    0x28, 0x34, 0x1D, 0x9D, 0x2C, 0x70, 0x1B, 0x1E, // 0x20 ! " # $ % & '
+    0x1F, 0x29, 0x2D, 0x6A, 0x0D, 0x20, 0x72, 0x73, // 0x28 ( ) * + , - . /
+    0x64, 0x5B, 0x5C, 0x5D, 0x5E, 0x5F, 0x60, 0x61, // 0x30 0 1 2 3 4 5 6 7
+    0x62, 0x63, 0x33, 0x32, 0x35, 0x2A, 0x75, 0x4D, // 0x38 8 9 : ; < = > ?
+    0xA4, 0x51, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47, // 0x40 @ A B C D E F G
+    0x48, 0x49, 0x4A, 0x4B, 0x4C, 0x6F, 0x4E, 0x4F, // 0x48 H I J K L M N O
+    0x50, 0x41, 0x52, 0x53, 0x54, 0x55, 0x56, 0x5A, // 0x50 P Q R S T U V W
+    0x58, 0x59, 0x57, 0x9F, 0xA2, 0xA9, 0xA3, 0x22, // 0x58 X Y Z [ \ ] ^ _
+    0xA1, 0x11, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, // 0x60 ` a b c d e f g
+    0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x2F, 0x0E, 0x0F, // 0x68 h i j k l m n o
+    0x10, 0x01, 0x12, 0x13, 0x14, 0x15, 0x16, 0x1A, // 0x70 p q r s t u v w
+    0x18, 0x19, 0x17, 0x9E, 0xA0, 0xAA, 0x9C, 0x00, // 0x78 x y z { | } ~
+};
+
+hid_locale_t locale_fr {
+    "FR",
+    locale_keys,
+    ascii_fr, 128,
+    NULL, 0,
+    NULL, 0
+};
+
+// ===== RU ===== //
+const uint8_t ascii_ru[128] PROGMEM = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 0x00
+    0x26, 0x27, 0x25, 0x00, 0x00, 0x00, 0x00, 0x00, // 0x08
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 0x10
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 0x18
+    0x28, 0x5B, 0x5C, 0x00, 0x00, 0x5F, 0x00, 0x00, // 0x20 ! " # $ % & '
+    0x63, 0x64, 0x62, 0x6A, 0x74, 0x29, 0x34, 0x6D, // 0x28 ( ) * + , - . /
+    0x24, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0x20, 0x21, // 0x30 0 1 2 3 4 5 6 7
+    0x22, 0x23, 0x60, 0x5E, 0x00, 0x64, 0x40, 0x61, // 0x38 8 9 : ; < = > ?
+    0x00, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47, // 0x40 @ A B C D E F G
+    0x48, 0x49, 0x4A, 0x4B, 0x4C, 0x4D, 0x4E, 0x4F, // 0x48 H I J K L M N O
+    0x50, 0x51, 0x52, 0x53, 0x54, 0x55, 0x56, 0x57, // 0x50 P Q R S T U V W
+    0x58, 0x59, 0x5A, 0x00, 0x2D, 0x00, 0x00, 0x69, // 0x58 X Y Z [ \ ] ^ _
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, // 0x60 ` a b c d e f g
+    0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, // 0x68 h i j k l m n o
+    0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, // 0x70 p q r s t u v w
+    0x18, 0x19, 0x1A, 0x00, 0x00, 0x00, 0x00, 0x26, // 0x78 x y z { | } ~
+};
+
+// Packed character << 8 | code
+const uint16_t extended_ascii_ru[] PROGMEM = {
+    0x71A1, // Ё
+    0x46B0, // А
+    0x72B1, // Б
+    0x55B3, // Г
+    0x4CB4, // Д
+    0x54B5, // Е
+    0x6FB6, // Ж
+    0x50B7, // З
+    0x42B8, // И
+    0x51B9, // Й
+    0x52BA, // К
+    0x4BBB, // Л
+    0x56BC, // М
+    0x59BD, // Н
+    0x4ABE, // О
+    0x47BF, // П
+    0x48C0, // Р
+    0x43C1, // С
+    0x4EC2, // Т
+    0x45C3, // У
+    0x41C4, // Ф
+    0x6BC5, // Х
+    0x57C6, // Ц
+    0x58C7, // Ч
+    0x49C8, // Ш
+    0x4FC9, // Щ
+    0x6CCA, // Ъ
+    0x53CB, // Ы
+    0x4DCC, // Ь
+    0x70CD, // Э
+    0x73CE, // Ю
+    0x1ACF, // я
+    0x06D0, // а
+    0x32D1, // б
+    0x15D3, // г
+    0x0CD4, // д
+    0x14D5, // е
+    0x2FD6, // ж
+    0x10D7, // з
+    0x02D8, // и
+    0x11D9, // й
+    0x12DA, // к
+    0x0BDB, // л
+    0x16DC, // м
+    0x19DD, // н
+    0x0ADE, // о
+    0x07DF, // п
+    0x08E0, // р
+    0x03E1, // с
+    0x0EE2, // т
+    0x05E3, // у
+    0x01E4, // Ф
+    0x2BE5, // х
+    0x17E6, // ц
+    0x18E7, // ч
+    0x09E8, // ш
+    0x0FE9, // щ
+    0x2CEA, // ъ
+    0x13EB, // ы
+    0x0DEC, // ь
+    0x30ED, // э
+    0x33EE, // ю
+    0x5AEF, // Я
+    0x31F1, // ё
+};
+
+// Packed character << 24 | codepoint
+const uint32_t utf8_ru[] PROGMEM = {
+    0x71000401, // Ё
+    0x46000410, // А
+    0x72000411, // Б
+    0x44000412, // В
+    0x55000413, // Г
+    0x4C000414, // Д
+    0x54000415, // Е
+    0x6F000416, // Ж
+    0x50000417, // З
+    0x42000418, // И
+    0x51000419, // Й
+    0x5200041A, // К
+    0x4B00041B, // Л
+    0x5600041C, // М
+    0x5900041D, // Н
+    0x4A00041E, // О
+    0x4700041F, // П
+    0x48000420, // Р
+    0x43000421, // С
+    0x4E000422, // Т
+    0x45000423, // У
+    0x41000424, // Ф
+    0x6B000425, // Х
+    0x57000426, // Ц
+    0x58000427, // Ч
+    0x49000428, // Ш
+    0x4F000429, // Щ
+    0x6C00042A, // Ъ
+    0x5300042B, // Ы
+    0x4D00042C, // Ь
+    0x7000042D, // Э
+    0x7300042E, // Ю
+    0x5A00042F, // Я
+    0x06000430, // а
+    0x32000431, // б
+    0x04000432, // в
+    0x15000433, // г
+    0x0C000434, // д
+    0x14000435, // е
+    0x2F000436, // ж
+    0x10000437, // з
+    0x02000438, // и
+    0x11000439, // й
+    0x1200043A, // к
+    0x0B00043B, // л
+    0x1600043C, // м
+    0x1900043D, // н
+    0x0A00043E, // о
+    0x0700043F, // п
+    0x08000440, // р
+    0x03000441, // с
+    0x0E000442, // т
+    0x05000443, // у
+    0x01000444, // ф
+    0x2B000445, // х
+    0x17000446, // ц
+    0x18000447, // ч
+    0x09000448, // ш
+    0x0F000449, // щ
+    0x2C00044A, // ъ
+    0x1300044B, // ы
+    0x0D00044C, // ь
+    0x3000044D, // э
+    0x3300044E, // ю
+    0x1A00044F, // я
+    0x31000451, // ё
+};
+
+hid_locale_t locale_ru {
+    "RU",
+    locale_keys,
+    ascii_ru, 128,
+    extended_ascii_ru, sizeof(extended_ascii_ru) / sizeof(uint16_t),
+    utf8_ru, sizeof(utf8_ru) / sizeof(uint32_t)
+};
+
+// ===== DK ===== //
+const uint8_t ascii_dk[128] PROGMEM = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 0x00
+    0x26, 0x27, 0x25, 0x00, 0x00, 0x00, 0x00, 0x00, // 0x08
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 0x10
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 0x18
+    0x28, 0x5B, 0x5C, 0x5D, 0x9E, 0x5F, 0x60, 0x2D, // 0x20 ! " # $ % & '
+    0x62, 0x63, 0x6D, 0x29, 0x32, 0x34, 0x33, 0x61, // 0x28 ( ) * + , - . /
+    0x24, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0x20, 0x21, // 0x30 0 1 2 3 4 5 6 7
+    0x22, 0x23, 0x73, 0x72, 0x35, 0x64, 0x75, 0x69, // 0x38 8 9 : ; < = > ?
+    0x9C, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47, // 0x40 @ A B C D E F G
+    0x48, 0x49, 0x4A, 0x4B, 0x4C, 0x4D, 0x4E, 0x4F, // 0x48 H I J K L M N O
+    0x50, 0x51, 0x52, 0x53, 0x54, 0x55, 0x56, 0x57, // 0x50 P Q R S T U V W
+    0x58, 0x59, 0x5A, 0xA2, 0xB5, 0xA3, 0x6C, 0x74, // 0x58 X Y Z [ \ ] ^ _
+    0x6A, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, // 0x60 ` a b c d e f g
+    0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, // 0x68 h i j k l m n o
+    0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, // 0x70 p q r s t u v w
+    0x18, 0x19, 0x1A, 0xA1, 0xAA, 0xA4, 0xAC, 0x26, // 0x78 x y z { | } ~
+};
+
+// Packed character << 8 | code
+const uint16_t extended_ascii_dk[] PROGMEM = {
+    0x6B85, // Å
+    0x6F86, // Æ
+    0x7098, // Ø
+    0x9DA3, // £
+    0x5EA4, // ¤
+    0x2BA5, // å
+    0x2FA6, // æ
+    0x71A7, // §
+    0x30B8, // ø
+};
+
+// Packed character << 24 | codepoint
+const uint32_t utf8_dk[] PROGMEM = {
+    0x6B0000C5, // Å
+    0x6F0000C6, // Æ
+    0x700000D8, // Ø
+    0x2B0000E5, // å
+    0x2F0000E6, // æ
+    0x700000E7, // ç
+    0x300000F8, // ø
+};
+
+hid_locale_t locale_dk {
+    "DK",
+    locale_keys,
+    ascii_dk, 128,
+    extended_ascii_dk, sizeof(extended_ascii_dk) / sizeof(uint16_t),
+    utf8_dk, sizeof(utf8_dk) / sizeof(uint32_t)
+};
+
+hid_locale_t* const locales[LOCALES_LEN] {
+    &locale_us, &locale_de, &locale_gb, &locale_es, &locale_fr, &locale_ru, &locale_dk
+};
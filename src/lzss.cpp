@@ -0,0 +1,144 @@
+/*
+   This software is licensed under the MIT License. See the license file for details.
+   Source: https://github.com/spacehuhntech/WiFiDuck
+ */
+
+#include "lzss.h"
+
+#include "config.h"
+#include "debug.h"
+
+namespace lzss {
+    // ===== PRIVATE ===== //
+
+    // Next count bits of the compressed data, -1 at the end of the file
+    int bits(decoder_t* d, File& f, uint8_t count) {
+        int res = 0;
+
+        while (count-- > 0) {
+            if (d->bitMask == 0) {
+                if (d->inI == d->inLen) {
+                    d->inLen = f.read(d->in, LZSS_INPUT_SIZE);
+                    d->inI   = 0;
+
+                    if (d->inLen == 0) {
+                        d->eof = true;
+                        return -1;
+                    }
+                }
+
+                ++d->inI;
+                d->bitMask = 0x80;
+            }
+
+            res = (res << 1) | ((d->in[d->inI - 1] & d->bitMask) ? 1 : 0);
+            d->bitMask >>= 1;
+        }
+
+        return res;
+    }
+
+    void reset(decoder_t* d) {
+        // heatshrink starts with a window of zeros
+        memset(d->window, 0, 1 << d->h.window_bits);
+
+        d->head     = 0;
+        d->out      = 0;
+        d->copyLen  = 0;
+        d->copyFrom = 0;
+        d->inLen    = 0;
+        d->inI      = 0;
+        d->bitMask  = 0;
+        d->eof      = false;
+    }
+
+    // ===== PUBLIC ===== //
+    bool readHeader(File& f, header_t& h) {
+        return (f.read((uint8_t*)&h, sizeof(header_t)) == sizeof(header_t)) &&
+               (memcmp(h.magic, DUCKZ_MAGIC, sizeof(h.magic)) == 0) && (h.version == DUCKZ_VERSION) &&
+               (h.window_bits >= 4) && (h.window_bits <= LZSS_MAX_WINDOW_BITS) &&
+               (h.lookahead_bits >= 3) && (h.lookahead_bits < h.window_bits);
+    }
+
+    // A decoder when the file at its current position is compressed, otherwise the position stays
+    decoder_t* open(File& f) {
+        uint32_t start = f.position();
+        header_t h;
+
+        if (!readHeader(f, h)) {
+            f.seek(start, SeekSet);
+            return NULL;
+        }
+
+        // The window is behind the decoder
+        decoder_t* d = (decoder_t*)malloc(sizeof(decoder_t) + (1 << h.window_bits));
+
+        if (!d) {
+            debugln("Not enough memory for decompressing");
+            f.seek(start, SeekSet);
+            return NULL;
+        }
+
+        d->h      = h;
+        d->window = (uint8_t*)(d + 1);
+        reset(d);
+
+        return d;
+    }
+
+    void close(decoder_t* d) {
+        free(d);
+    }
+
+    // Starts again at the beginning of the compressed data
+    void rewind(decoder_t* d, File& f) {
+        f.seek(sizeof(header_t), SeekSet);
+        reset(d);
+    }
+
+    size_t decode(decoder_t* d, File& f, uint8_t* dst, size_t len) {
+        uint16_t mask = (1 << d->h.window_bits) - 1;
+        size_t   n    = 0;
+
+        while ((n < len) && (d->out < d->h.size)) {
+            int c;
+
+            if (d->copyLen > 0) {
+                c = d->window[(d->head - d->copyFrom) & mask];
+                --d->copyLen;
+            } else {
+                int tag = bits(d, f, 1);
+
+                if (tag < 0) break;
+
+                if (tag == 1) {
+                    c = bits(d, f, 8);
+
+                    if (c < 0) break;
+                } else {
+                    int from  = bits(d, f, d->h.window_bits);
+                    int count = bits(d, f, d->h.lookahead_bits);
+
+                    if ((from < 0) || (count < 0)) break;
+
+                    d->copyFrom = from + 1;
+                    d->copyLen  = count + 1;
+
+                    continue;
+                }
+            }
+
+            d->window[d->head & mask] = c;
+            ++d->head;
+            ++d->out;
+            dst[n++] = c;
+        }
+
+        return n;
+    }
+
+    // Also when the file ended early, nothing more can be decoded then
+    bool done(decoder_t* d) {
+        return (d->out >= d->h.size) || d->eof;
+    }
+}
@@ -14,7 +14,9 @@
 
 #include "led.h"
 #include "keyboard.h"
+#include "tracer.h"
 #include "duckparser.h"
+#include "benchmark.h"
 
 void setup() {
     debug_init();
@@ -43,6 +45,13 @@ void setup() {
 
 void loop() {
     webserver::update();
+    keyboard::update();
+    tracer::update();
     duckscript::nextLine();
+    benchmark::update();
     debug_update();
+
+    // Let the CPU idle while the script waits for a DELAY
+    unsigned int idle = duckscript::idleTime();
+    if (idle > 0) delay(_min(idle, IDLE_MAX_TIME));
 }
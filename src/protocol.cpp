@@ -0,0 +1,320 @@
+/*
+   This software is licensed under the MIT License. See the license file for details.
+   Source: https://github.com/spacehuhntech/WiFiDuck
+ */
+
+#include "protocol.h"
+
+#include "config.h"
+#include "debug.h"
+
+#include "spiffs.h"
+#include "duckscript.h"
+#include "tracer.h"
+#include "upload.h"
+#include "duckcompiler.h"
+#include "layouts.h"
+
+namespace protocol {
+    // ===== PRIVATE ===== //
+    typedef struct request_t {
+        const uint8_t* data;
+        size_t         len;
+        size_t         i; // Start of the next field
+    } request_t;
+
+    uint8_t* res { NULL }; // Only allocated after a client said hello
+    size_t   resLen { 0 };
+    uint8_t* req { NULL }; // Parts of a request, only allocated when one was split
+    Print  * output { NULL };
+
+    // Next field of a request, false when there's none
+    bool field(request_t& r, const uint8_t*& data, size_t& len) {
+        uint16_t n;
+
+        if (r.i + sizeof(n) > r.len) return false;
+
+        memcpy(&n, &r.data[r.i], sizeof(n));
+
+        if (r.i + sizeof(n) + n > r.len) return false;
+
+        data = &r.data[r.i + sizeof(n)];
+        len  = n;
+        r.i += sizeof(n) + n;
+
+        return true;
+    }
+
+    bool field(request_t& r, String& s) {
+        const uint8_t* data;
+        size_t len;
+
+        if (!field(r, data, len)) return false;
+
+        s = String();
+        s.reserve(len);
+
+        for (size_t i = 0; i < len; ++i) s += (char)data[i];
+
+        return true;
+    }
+
+    bool field(request_t& r, uint32_t& v) {
+        const uint8_t* data;
+        size_t len;
+
+        if (!field(r, data, len) || (len != sizeof(v))) return false;
+
+        memcpy(&v, data, sizeof(v));
+
+        return true;
+    }
+
+    bool add(const void* data, size_t len) {
+        uint16_t n = len;
+
+        if (resLen + sizeof(n) + len > PROTOCOL_FRAME_SIZE) return false;
+
+        memcpy(&res[resLen], &n, sizeof(n));
+        memcpy(&res[resLen + sizeof(n)], data, len);
+        resLen += sizeof(n) + len;
+
+        return true;
+    }
+
+    bool add(const String& s) {
+        return add(s.c_str(), s.length());
+    }
+
+    bool add(uint32_t v) {
+        return add(&v, sizeof(v));
+    }
+
+    // Sends the response so far, the header stays for the next part
+    void send(uint8_t status) {
+        res[3] = status;
+
+        output->write(res, resLen);
+        output->flush();
+
+        resLen = PROTOCOL_RESPONSE_HEADER_SIZE;
+    }
+
+    void error(const String& msg) {
+        resLen = PROTOCOL_RESPONSE_HEADER_SIZE;
+        add(msg.c_str(), _min((size_t)msg.length(), PROTOCOL_FRAME_SIZE - PROTOCOL_RESPONSE_HEADER_SIZE - sizeof(uint16_t)));
+        send(PROTOCOL_ERROR);
+    }
+
+    void hello() {
+        uint8_t version = PROTOCOL_VERSION;
+
+        add(&version, sizeof(version));
+        add((uint32_t)PROTOCOL_FRAME_SIZE);
+        send(PROTOCOL_OK);
+    }
+
+    void run(request_t& r) {
+        String fileName;
+
+        if (!field(r, fileName)) return error("missing file");
+        if (!spiffs::exists(fileName)) return error(fileName + " doesn't exist");
+
+        duckscript::run(fileName);
+        send(PROTOCOL_OK);
+    }
+
+    void stop(request_t& r) {
+        String fileName;
+
+        field(r, fileName);
+
+        duckscript::stop(fileName);
+
+        if ((fileName.length() == 0) || (fileName == tracer::currentReplay())) {
+            tracer::stopReplay();
+        }
+
+        send(PROTOCOL_OK);
+    }
+
+    void status() {
+        uint8_t state = PROTOCOL_IDLE;
+        String  name;
+        uint32_t a    = 0;
+        uint32_t b    = 0;
+
+        if (duckscript::isRunning()) {
+            state = PROTOCOL_RUNNING;
+            name  = duckscript::currentScript();
+            a     = duckscript::currentLine();
+        } else if (tracer::replaying()) {
+            state = PROTOCOL_REPLAYING;
+            name  = tracer::currentReplay();
+        } else if (upload::uploading()) {
+            state = PROTOCOL_UPLOADING;
+            name  = upload::currentUpload();
+            a     = upload::getReceived();
+            b     = upload::getSize();
+        }
+
+        add(&state, sizeof(state));
+        add(name);
+        add(a);
+        add(b);
+        send(PROTOCOL_OK);
+    }
+
+    // A file that doesn't fit anymore starts a new part
+    void addFile(const String& name, size_t size, size_t logical) {
+        if (resLen + 3 * sizeof(uint16_t) + name.length() + 2 * sizeof(uint32_t) > PROTOCOL_FRAME_SIZE) {
+            send(PROTOCOL_PART);
+        }
+
+        add(name);
+        add((uint32_t)size);
+        add((uint32_t)logical);
+    }
+
+    void ls(request_t& r) {
+        String dirName;
+
+        field(r, dirName);
+
+        spiffs::eachFile(dirName, addFile);
+        send(PROTOCOL_OK);
+    }
+
+    // As much of the file as fits into one response
+    void read(request_t& r) {
+        String   fileName;
+        uint32_t offset, len;
+
+        if (!field(r, fileName) || !field(r, offset) || !field(r, len)) return error("missing field");
+
+        File f = spiffs::openRead(fileName);
+
+        if (!f) return error("couldn't open " + fileName);
+
+        add((uint32_t)f.size());
+
+        uint16_t n = _min((size_t)len, PROTOCOL_FRAME_SIZE - resLen - sizeof(uint16_t));
+
+        if ((offset > f.size()) || !f.seek(offset, SeekSet)) n = 0;
+        else n = f.read(&res[resLen + sizeof(n)], n);
+
+        f.close();
+
+        memcpy(&res[resLen], &n, sizeof(n));
+        resLen += sizeof(n) + n;
+
+        send(PROTOCOL_OK);
+    }
+
+    void write(request_t& r) {
+        String   fileName;
+        uint32_t offset;
+        const uint8_t* data;
+        size_t len;
+
+        if (!field(r, fileName) || !field(r, offset) || !field(r, data, len)) return error("missing field");
+
+        uint32_t size = spiffs::exists(fileName) ? spiffs::size(fileName) : 0;
+
+        if ((offset != 0) && (offset != size)) {
+            return error("offset " + String(offset) + " isn't 0 or the size " + String(size));
+        }
+
+        File f = (offset == 0) ? spiffs::openWrite(fileName) : spiffs::openAppend(fileName);
+
+        bool written = f && (f.write(data, len) == len);
+
+        f.close();
+
+        if (!written) return error("couldn't write " + fileName);
+
+        duckcompiler::invalidate(fileName);
+        layouts::invalidate(fileName);
+
+        add((uint32_t)(offset + len));
+        send(PROTOCOL_OK);
+    }
+
+    // Starts the response to the header of a request, false before a client said hello
+    bool answer(const uint8_t* data, Print& out) {
+        if ((data[0] == PROTOCOL_HELLO) && !res) {
+            res = (uint8_t*)malloc(PROTOCOL_FRAME_SIZE);
+
+            if (!res) debugln("Not enough memory for the binary protocol");
+        }
+
+        if (!res) return false;
+
+        output = &out;
+
+        res[0] = data[0] | PROTOCOL_RESPONSE;
+        res[1] = data[1];
+        res[2] = data[2];
+        resLen = PROTOCOL_RESPONSE_HEADER_SIZE;
+
+        return true;
+    }
+
+    // ===== PUBLIC ===== //
+    void end() {
+        free(res);
+        res = NULL;
+
+        free(req);
+        req = NULL;
+    }
+
+    void handle(const uint8_t* data, size_t len, Print& out) {
+        if (len < PROTOCOL_REQUEST_HEADER_SIZE) return;
+        if (!answer(data, out)) return;
+
+        request_t r { data, len, PROTOCOL_REQUEST_HEADER_SIZE };
+
+        switch (data[0]) {
+            case PROTOCOL_HELLO: hello(); break;
+            case PROTOCOL_RUN: run(r); break;
+            case PROTOCOL_STOP: stop(r); break;
+            case PROTOCOL_STATUS: status(); break;
+            case PROTOCOL_LS: ls(r); break;
+            case PROTOCOL_READ: read(r); break;
+            case PROTOCOL_WRITE: write(r); break;
+            default: error("unknown opcode " + String(data[0]));
+        }
+
+        output = NULL;
+    }
+
+    void receive(const uint8_t* data, size_t len, size_t index, size_t total, Print& out) {
+        if ((index == 0) && (len == total)) return handle(data, len, out);
+
+        if (total > PROTOCOL_FRAME_SIZE) {
+            // Only the first part has the header to answer
+            if ((index == 0) && (len >= PROTOCOL_REQUEST_HEADER_SIZE) && answer(data, out)) {
+                error("request of " + String(total) + " bytes is larger than " + String(PROTOCOL_FRAME_SIZE));
+                output = NULL;
+            }
+            return;
+        }
+
+        if (!req) {
+            // A client has to say hello before its first request
+            if (!res) return;
+
+            req = (uint8_t*)malloc(PROTOCOL_FRAME_SIZE);
+
+            if (!req) {
+                debugln("Not enough memory for a split request");
+                return;
+            }
+        }
+
+        memcpy(&req[index], data, len);
+
+        if (index + len == total) handle(req, total, out);
+    }
+}
@@ -0,0 +1,137 @@
+/*
+   This software is licensed under the MIT License. See the license file for details.
+   Source: https://github.com/spacehuhntech/WiFiDuck
+ */
+
+#include "reader.h"
+
+namespace reader {
+    // ===== PUBLIC ===== //
+    void begin(reader_t& r, File file) {
+        r.file    = file;
+        r.len     = 0;
+        r.i       = 0;
+        r.decoder = r.file ? lzss::open(r.file) : NULL;
+    }
+
+    // The file is closed once no one else holds it, like a handle of spiffs::openPooled()
+    void close(reader_t& r) {
+        lzss::close(r.decoder);
+        r.decoder = NULL;
+        r.file    = File();
+        r.len = 0;
+        r.i   = 0;
+    }
+
+    // Moves the rest of buf to the front and reads as much as fits behind it
+    bool fill(reader_t& r) {
+        memmove(r.buf, &r.buf[r.i], r.len - r.i);
+        r.len -= r.i;
+        r.i    = 0;
+
+        if (!r.file || (r.len == BUFFER_SIZE)) return false;
+
+        size_t n;
+
+        if (r.decoder) n = lzss::decode(r.decoder, r.file, (uint8_t*)&r.buf[r.len], BUFFER_SIZE - r.len);
+        else n = r.file.read((uint8_t*)&r.buf[r.len], BUFFER_SIZE - r.len);
+
+        r.len += n;
+
+        return n > 0;
+    }
+
+    // buf holds the end of the file
+    bool last(reader_t& r) {
+        if (r.decoder) return lzss::done(r.decoder);
+        return !r.file || !r.file.available();
+    }
+
+    size_t available(reader_t& r) {
+        if (r.decoder) return (r.len - r.i) + (lzss::done(r.decoder) ? 0 : r.decoder->h.size - r.decoder->out);
+        return (r.len - r.i) + (r.file ? r.file.available() : 0);
+    }
+
+    // The next n bytes in one piece, NULL when the file ends before
+    const uint8_t* peek(reader_t& r, size_t n) {
+        if (n > BUFFER_SIZE) return NULL;
+
+        if (r.len - r.i < n) fill(r);
+
+        return (r.len - r.i < n) ? NULL : (const uint8_t*)&r.buf[r.i];
+    }
+
+    size_t read(reader_t& r, uint8_t* dst, size_t n) {
+        size_t done = 0;
+
+        while (done < n) {
+            if ((r.i == r.len) && !fill(r)) break;
+
+            size_t part = _min(n - done, r.len - r.i);
+
+            memcpy(&dst[done], &r.buf[r.i], part);
+            r.i  += part;
+            done += part;
+        }
+
+        return done;
+    }
+
+    // Reads up to and including the delimiter, or max_len - 1 bytes, dst is terminated with '\0'
+    size_t readUntil(reader_t& r, char* dst, char delimiter, size_t max_len) {
+        size_t done = 0;
+
+        if (max_len == 0) return 0;
+
+        while (done < max_len - 1) {
+            if ((r.i == r.len) && !fill(r)) break;
+
+            size_t part  = _min(max_len - 1 - done, r.len - r.i);
+            char * found = (char*)memchr(&r.buf[r.i], delimiter, part);
+
+            if (found) part = found - &r.buf[r.i] + 1;
+
+            memcpy(&dst[done], &r.buf[r.i], part);
+            r.i  += part;
+            done += part;
+
+            if (found) break;
+        }
+
+        dst[done] = '\0';
+
+        return done;
+    }
+
+    // Position in the file of the next byte that will be read
+    uint32_t position(reader_t& r) {
+        return (r.decoder ? r.decoder->out : r.file.position()) - (r.len - r.i);
+    }
+
+    void seek(reader_t& r, uint32_t pos) {
+        // Still in buf, a REPEAT of a short line doesn't have to read it again
+        uint32_t start = (r.decoder ? r.decoder->out : r.file.position()) - r.len;
+
+        if ((pos >= start) && (pos <= start + r.len)) {
+            r.i = pos - start;
+            return;
+        }
+
+        r.len = 0;
+        r.i   = 0;
+
+        if (!r.decoder) {
+            r.file.seek(pos, SeekSet);
+            return;
+        }
+
+        // Compressed data can only be decompressed from the start
+        if (pos < r.decoder->out) lzss::rewind(r.decoder, r.file);
+
+        while (r.decoder->out < pos) {
+            size_t n = _min((size_t)(pos - r.decoder->out), (size_t)BUFFER_SIZE);
+
+            if (lzss::decode(r.decoder, r.file, (uint8_t*)r.buf, n) == 0) break;
+        }
+    }
+}
@@ -55,23 +55,16 @@ namespace settings {
         eeprom::saveObject(SETTINGS_ADDRES, data);
     }
 
-    String toString() {
-        String s;
-
-        s += "ssid=";
-        s += getSSID();
-        s += "\n";
-        s += "password=";
-        s += getPassword();
-        s += "\n";
-        s += "channel=";
-        s += getChannel();
-        s += "\n";
-        s += "autorun=";
-        s += getAutorun();
-        s += "\n";
-
-        return s;
+    void print(Print& out) {
+        out.print("ssid=");
+        out.print(getSSID());
+        out.print("\npassword=");
+        out.print(getPassword());
+        out.print("\nchannel=");
+        out.print(getChannel());
+        out.print("\nautorun=");
+        out.print(getAutorun());
+        out.print('\n');
     }
 
     const char* getSSID() {
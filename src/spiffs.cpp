@@ -8,23 +8,267 @@
 #include "config.h"
 #include "debug.h"
 
+#include "duckcompiler.h" // DUCKC_EXTENSION
+#include "reader.h"
+#include "lzss.h"
+#include <LittleFS.h>
+#include <user_interface.h> // system_get_free_heap_size
+
+#define BENCH_FILE "/fsbench.tmp"
+#define BENCH_OPENS 20
+
 namespace spiffs {
-    File streamFile;
+    reader::reader_t* stream { NULL }; // Only allocated while a stream is open
 
     // ===== PRIVATE ===== //
+#if STORAGE_LITTLEFS
+    FS* storage { &LittleFS };
+#else // if STORAGE_LITTLEFS
+    FS* storage { &SPIFFS };
+#endif // if STORAGE_LITTLEFS
+
+    // Files of the directory that was listed last, so ls doesn't read the flash every time
+    typedef struct index_entry {
+        index_entry* next;
+        String       name;
+        size_t       size;
+        size_t       logical; // Uncompressed size of a compressed script
+    } index_entry;
+
+    index_entry* fileIndex { NULL };
+    String indexDir;
+    bool   indexValid { false };
+
+    // Read handles that are kept open, so a file that is read again and again
+    // isn't looked up every time
+    typedef struct pooled_file {
+        String   name;
+        File     file;
+        uint32_t last_used;
+    } pooled_file;
+
+    pooled_file pool[STORAGE_POOL_SIZE];
+    uint32_t    poolTime { 0 };
+
+    // Output of an ls that is only timed
+    class NullPrint : public Print {
+        public:
+            size_t write(uint8_t c) override {
+                return 1;
+            }
+
+            size_t write(const uint8_t* buf, size_t len) override {
+                return len;
+            }
+    };
+
     void fixPath(String& path) {
         if (!path.startsWith("/")) {
             path = "/" + path;
         }
     }
 
+    // Drops the handle of a file that changes, it's closed once no one holds it anymore
+    void release(const String& fileName) {
+        for (size_t i = 0; i < STORAGE_POOL_SIZE; ++i) {
+            if (pool[i].name == fileName) {
+                pool[i].file = File();
+                pool[i].name = String();
+            }
+        }
+    }
+
+    void releaseAll() {
+        for (size_t i = 0; i < STORAGE_POOL_SIZE; ++i) {
+            pool[i].file = File();
+            pool[i].name = String();
+        }
+    }
+
+    void buildIndex(const String& dirName) {
+        invalidate();
+
+        index_entry** tail = &fileIndex;
+
+        Dir dir = storage->openDir(dirName);
+
+        // The directory already knows the sizes, no need to open every file
+        while (dir.next()) {
+            if (!dir.isFile()) continue;
+
+            // LittleFS names are relative to the directory
+            String fileName = dir.fileName();
+
+            if (!fileName.startsWith("/")) fileName = dirName + (dirName.endsWith("/") ? "" : "/") + fileName;
+
+            size_t size    = dir.fileSize();
+            size_t logical = size;
+
+            // Only compressed scripts are opened
+            if (fileName.endsWith(DUCKZ_EXTENSION)) {
+                File f = dir.openFile("r");
+                lzss::header_t h;
+
+                if (lzss::readHeader(f, h)) logical = h.size;
+            }
+
+            *tail = new index_entry { NULL, fileName, size, logical };
+            tail  = &(*tail)->next;
+        }
+
+        indexDir   = dirName;
+        indexValid = true;
+    }
+
+#if STORAGE_LITTLEFS
+    // A file that is kept in RAM while the flash is formatted
+    typedef struct moved_file {
+        moved_file* next;
+        String      name;
+        size_t      size;
+        uint8_t   * data;
+    } moved_file;
+
+    void freeFiles(moved_file* files) {
+        while (files) {
+            moved_file* next = files->next;
+
+            free(files->data);
+            delete files;
+            files = next;
+        }
+    }
+
+    // Blocks the files take in LittleFS, every file takes at least one
+    size_t blocks(moved_file* files, size_t blockSize) {
+        size_t n = STORAGE_LITTLEFS_SPARE;
+
+        for (moved_file* m = files; m; m = m->next) {
+            n += _max((size_t)1, (m->size + blockSize - 1) / blockSize);
+        }
+
+        return n;
+    }
+
+    bool writeFiles(FS& fs, moved_file* files) {
+        for (moved_file* m = files; m; m = m->next) {
+            File f = fs.open(m->name, "w");
+
+            if (!f || (f.write(m->data, m->size) != m->size)) {
+                debugf("Couldn't write %s\n", m->name.c_str());
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    // Moves the files of an older version from SPIFFS to LittleFS.
+    // Both use the same flash, so the files are kept in RAM while it's formatted.
+    // Returns false when they don't fit or couldn't be written, SPIFFS is used then.
+    bool migrate() {
+        SPIFFSConfig cfg;
+
+        cfg.setAutoFormat(false);
+        SPIFFS.setConfig(cfg);
+
+        if (!SPIFFS.begin()) return true; // Nothing to move
+
+        FSInfo info;
+
+        if (!SPIFFS.info(info) || (info.blockSize == 0)) return false;
+
+        moved_file* files = NULL;
+        size_t total      = 0;
+        bool   fits       = true;
+
+        Dir dir = SPIFFS.openDir("/");
+
+        while (fits && dir.next()) {
+            String name = dir.fileName();
+
+            // Compiled scripts are made again when they're run
+            if (name.endsWith(DUCKC_EXTENSION) || name.endsWith(DUCKL_EXTENSION)) continue;
+
+            size_t size = dir.fileSize();
+
+            total += size + sizeof(moved_file) + name.length();
+
+            if (total + STORAGE_MIGRATE_RESERVE > system_get_free_heap_size()) {
+                debugln("SPIFFS files don't fit into RAM, keeping SPIFFS");
+                fits = false;
+                break;
+            }
+
+            moved_file* m = new moved_file { files, name, size, (uint8_t*)malloc(size ? size : 1) };
+            files = m;
+
+            File f = dir.openFile("r");
+
+            if (!m->data || !f || (f.read(m->data, size) != size)) {
+                debugf("Couldn't read %s, keeping SPIFFS\n", name.c_str());
+                fits = false;
+            }
+        }
+
+        // LittleFS takes more space per file, nothing is formatted when they wouldn't fit
+        if (fits && (blocks(files, info.blockSize) > info.totalBytes / info.blockSize)) {
+            debugln("SPIFFS files don't fit into LittleFS, keeping SPIFFS");
+            fits = false;
+        }
+
+        if (!fits) {
+            freeFiles(files);
+            return false;
+        }
+
+        SPIFFS.end();
+
+        bool moved = LittleFS.format() && LittleFS.begin() && writeFiles(LittleFS, files);
+
+        if (moved) {
+            debugf("Moved %u bytes from SPIFFS to LittleFS\n", (unsigned int)total);
+        } else {
+            // RAM has the only copy now, it goes back to SPIFFS
+            debugln("Moving to LittleFS failed, restoring SPIFFS");
+
+            LittleFS.end();
+
+            if (!SPIFFS.format() || !SPIFFS.begin() || !writeFiles(SPIFFS, files)) {
+                debugln("Couldn't restore SPIFFS");
+            }
+
+            SPIFFS.end();
+        }
+
+        freeFiles(files);
+
+        return moved;
+    }
+
+#endif // if STORAGE_LITTLEFS
+
     // ===== PUBLIC ====== //
     void begin() {
-        debug("Initializing SPIFFS...");
-        if(!SPIFFS.begin())
-        {
-          format();
-          SPIFFS.begin();
+        debug("Initializing ");
+        debug(name());
+        debug("...");
+
+#if STORAGE_LITTLEFS
+        LittleFSConfig cfg;
+
+        cfg.setAutoFormat(false);
+        LittleFS.setConfig(cfg);
+
+        // Not LittleFS yet, the first start after an update from SPIFFS
+        if (!LittleFS.begin()) {
+            storage = migrate() ? &LittleFS : &SPIFFS;
+        }
+#endif  // if STORAGE_LITTLEFS
+
+        if (!storage->begin()) {
+            format();
+            storage->begin();
         }
         debugln("OK");
 
@@ -32,7 +276,7 @@ namespace spiffs {
 
         remove(FILE_NAME);
         create(FILE_NAME);
-        File f = open(FILE_NAME);
+        File f = openRead(FILE_NAME);
         if (!f) {
             format();
         } else {
@@ -42,73 +286,130 @@ namespace spiffs {
     }
 
     void format() {
-        debug("Formatting SPIFFS...");
-        SPIFFS.format();
+        invalidate();
+        releaseAll();
+
+        debug("Formatting ");
+        debug(name());
+        debug("...");
+        storage->format();
         debugln("OK");
     }
 
+    const char* name() {
+        return storage == &SPIFFS ? "SPIFFS" : "LittleFS";
+    }
+
     size_t size() {
         FSInfo fs_info;
 
-        SPIFFS.info(fs_info);
+        storage->info(fs_info);
         return fs_info.totalBytes;
     }
 
     size_t usedBytes() {
         FSInfo fs_info;
 
-        SPIFFS.info(fs_info);
+        storage->info(fs_info);
         return fs_info.usedBytes;
     }
 
     size_t freeBytes() {
         FSInfo fs_info;
 
-        SPIFFS.info(fs_info);
+        storage->info(fs_info);
         return fs_info.totalBytes - fs_info.usedBytes;
     }
 
     size_t size(String fileName) {
+        return openRead(fileName).size();
+    }
+
+    bool exists(String fileName) {
         fixPath(fileName);
 
-        File f = SPIFFS.open(fileName, "r");
+        return storage->exists(fileName);
+    }
+
+    File openRead(String fileName) {
+        fixPath(fileName);
 
-        return f.size();
+        return storage->open(fileName, "r");
     }
 
-    bool exists(String fileName) {
-        return SPIFFS.exists(fileName);
+    // Truncates the file
+    File openWrite(String fileName) {
+        fixPath(fileName);
+        invalidate();
+        release(fileName);
+
+        return storage->open(fileName, "w");
     }
 
-    File open(String fileName) {
+    // Can be read from the start, but everything is written at the end
+    File openAppend(String fileName) {
         fixPath(fileName);
+        invalidate();
+        release(fileName);
 
-        return SPIFFS.open(fileName, "a+");
+        return storage->open(fileName, "a+");
     }
 
-    void create(String fileName) {
+    // A read handle from the pool, at the start of the file.
+    // It's shared, so it has to be seeked before reading and must not be closed.
+    File openPooled(String fileName) {
         fixPath(fileName);
 
-        File f = SPIFFS.open(fileName, "a+");
+        pooled_file* p = NULL;
+
+        for (size_t i = 0; i < STORAGE_POOL_SIZE; ++i) {
+            if (pool[i].file && (pool[i].name == fileName)) {
+                p = &pool[i];
+                break;
+            }
+
+            if (!p || (pool[i].last_used < p->last_used)) p = &pool[i];
+        }
+
+        if (!p->file || (p->name != fileName)) {
+            if (!storage->exists(fileName)) return File();
+
+            p->file = storage->open(fileName, "r");
+            p->name = fileName;
+        }
+
+        p->last_used = ++poolTime;
+        p->file.seek(0, SeekSet);
+
+        return p->file;
+    }
+
+    void create(String fileName) {
+        File f = openAppend(fileName);
 
         f.close();
     }
 
     void remove(String fileName) {
         fixPath(fileName);
+        invalidate();
+        release(fileName);
 
-        SPIFFS.remove(fileName);
+        storage->remove(fileName);
     }
 
-    void rename(String oldName, String newName) {
+    bool rename(String oldName, String newName) {
         fixPath(oldName);
         fixPath(newName);
+        invalidate();
+        release(oldName);
+        release(newName);
 
-        SPIFFS.rename(oldName, newName);
+        return storage->rename(oldName, newName);
     }
 
     void write(String fileName, const char* str) {
-        File f = open(fileName);
+        File f = openAppend(fileName);
 
         if (f) {
             f.println(str);
@@ -120,7 +421,7 @@ namespace spiffs {
     }
 
     void write(String fileName, const uint8_t* buf, size_t len) {
-        File f = open(fileName);
+        File f = openAppend(fileName);
 
         if (f) {
             f.write(buf, len);
@@ -131,50 +432,179 @@ namespace spiffs {
         }
     }
 
-    String listDir(String dirName) {
-        String res;
+    // One line per file, written straight into out
+    void listDir(String dirName, Print& out) {
+        fixPath(dirName);
 
+        if (!indexValid || (indexDir != dirName)) buildIndex(dirName);
+
+        for (index_entry* e = fileIndex; e; e = e->next) {
+            out.print(e->name);
+            out.print(' ');
+            out.print((unsigned int)e->size);
+
+            if (e->logical != e->size) {
+                out.print(" (");
+                out.print((unsigned int)e->logical);
+                out.print(')');
+            }
+
+            out.print('\n');
+        }
+
+        if (!fileIndex) out.print('\n');
+    }
+
+    void eachFile(String dirName, FileFunction f) {
         fixPath(dirName);
 
-        Dir dir = SPIFFS.openDir(dirName);
+        if (!indexValid || (indexDir != dirName)) buildIndex(dirName);
 
-        while (dir.next()) {
-            res += dir.fileName();
-            res += ' ';
-            res += size(dir.fileName());
-            res += '\n';
+        for (index_entry* e = fileIndex; e; e = e->next) f(e->name, e->size, e->logical);
+    }
+
+    // Space that compressed scripts take and their uncompressed size
+    void compressedBytes(size_t& compressed, size_t& uncompressed) {
+        if (!indexValid || (indexDir != "/")) buildIndex("/");
+
+        compressed   = 0;
+        uncompressed = 0;
+
+        for (index_entry* e = fileIndex; e; e = e->next) {
+            if (e->logical != e->size) {
+                compressed   += e->size;
+                uncompressed += e->logical;
+            }
         }
+    }
+
+    void invalidate() {
+        while (fileIndex) {
+            index_entry* next = fileIndex->next;
 
-        if (res.length() == 0) {
-            res += "\n";
+            delete fileIndex;
+            fileIndex = next;
         }
 
+        indexValid = false;
+    }
+
+    // Measures the file system with a temporary file of STORAGE_BENCH_SIZE bytes
+    void benchmark(bench_t& b) {
+        uint8_t buf[256];
+
+        memset(buf, 'x', sizeof(buf));
+
+        // Sequential write
+        uint32_t t = micros();
+        File     f = openWrite(BENCH_FILE);
+
+        for (size_t i = 0; f && i < STORAGE_BENCH_SIZE; i += sizeof(buf)) f.write(buf, sizeof(buf));
+        f.close();
+
+        uint32_t writeTime = micros() - t;
+
+        // Open latency
+        t = micros();
+
+        for (size_t i = 0; i < BENCH_OPENS; ++i) {
+            f = openRead(BENCH_FILE);
+            f.close();
+        }
+
+        uint32_t openTime = (micros() - t) / BENCH_OPENS;
+
+        // Pooled open latency
+        t = micros();
+
+        for (size_t i = 0; i < BENCH_OPENS; ++i) openPooled(BENCH_FILE);
+
+        uint32_t pooledTime = (micros() - t) / BENCH_OPENS;
+
+        // Sequential read
+        size_t read = 0;
+
+        t = micros();
+        f = openRead(BENCH_FILE);
+
+        while (f && f.available()) read += f.read(buf, sizeof(buf));
+        f.close();
+
+        uint32_t readTime = micros() - t;
+
+        remove(BENCH_FILE);
+
+        // Directory listing, the first one reads the flash and the second one the index
+        NullPrint none;
+
+        t = micros();
+        listDir("/", none);
+
+        uint32_t listTime = micros() - t;
+
+        t = micros();
+        listDir("/", none);
+
+        uint32_t cachedTime = micros() - t;
+
+        b.open   = openTime;
+        b.pooled = pooledTime;
+        b.read   = read * 1000 / _max(readTime, 1U);
+        b.write  = (uint32_t)STORAGE_BENCH_SIZE * 1000 / _max(writeTime, 1U);
+        b.bytes  = read;
+        b.list   = listTime;
+        b.cached = cachedTime;
+        b.files  = 0;
+
+        for (index_entry* e = fileIndex; e; e = e->next) ++b.files;
+    }
+
+    String benchmark() {
+        bench_t b;
+
+        benchmark(b);
+
+        String res;
+
+        res += String(name()) + "\n";
+        res += "open: " + String(b.open) + " us, " + String(b.pooled) + " us pooled\n";
+        res += "read: " + String(b.read) + " KB/s (" + String(b.bytes) + " bytes)\n";
+        res += "write: " + String(b.write) + " KB/s\n";
+        res += "ls: " + String(b.list) + " us, " + String(b.cached) + " us cached (" + String(b.files) + " files)";
+
         return res;
     }
 
     void streamOpen(String fileName) {
         streamClose();
-        streamFile = open(fileName);
-        if (!streamFile) debugln("ERROR: No stream file open");
+        invalidate();
+
+        stream = new reader::reader_t;
+        reader::begin(*stream, openAppend(fileName));
+
+        if (!stream->file) debugln("ERROR: No stream file open");
     }
 
     void streamWrite(const char* buf, size_t len) {
-        if (streamFile) streamFile.write((uint8_t*)buf, len);
-        else debugln("ERROR: No stream file open");
+        invalidate();
+
+        if (streaming()) {
+            stream->file.write((uint8_t*)buf, len);
+
+            // The file is at its end after writing
+            stream->len = stream->i = 0;
+        } else {
+            debugln("ERROR: No stream file open");
+        }
     }
 
     size_t streamRead(char* buf, size_t len) {
-        if (streamFile) {
-            size_t i;
-
-            for (i = 0; i<len; ++i) {
-                if (!streamFile.available() || (i == len-1)) {
-                    buf[i] = '\0';
-                    break;
-                } else {
-                    buf[i] = streamFile.read();
-                }
-            }
+        if (streaming()) {
+            if (len == 0) return 0;
+
+            size_t i = reader::read(*stream, (uint8_t*)buf, len - 1);
+
+            buf[i] = '\0';
 
             return i;
         } else {
@@ -184,21 +614,8 @@ namespace spiffs {
     }
 
     size_t streamReadUntil(char* buf, char delimiter, size_t max_len) {
-        if (streamFile) {
-            size_t i;
-            char   c = 'x';
-
-            for (i = 0; i<max_len; ++i) {
-                if ((c == delimiter) || !streamFile.available() || (i == max_len-1)) {
-                    buf[i] = '\0';
-                    break;
-                } else {
-                    c      = streamFile.read();
-                    buf[i] = c;
-                }
-            }
-
-            return i;
+        if (streaming()) {
+            return reader::readUntil(*stream, buf, delimiter, max_len);
         } else {
             debugln("ERROR: No stream file open");
             return 0;
@@ -206,15 +623,19 @@ namespace spiffs {
     }
 
     void streamClose() {
-        streamFile.close();
+        if (!stream) return;
+
+        reader::close(*stream);
+        delete stream;
+        stream = NULL;
     }
 
     bool streaming() {
-        return streamFile;
+        return stream && stream->file;
     }
 
     size_t streamAvailable() {
-        if (!streamFile) return 0;
-        return streamFile.available();
+        if (!streaming()) return 0;
+        return reader::available(*stream);
     }
 }
@@ -0,0 +1,194 @@
+/*
+   This software is licensed under the MIT License. See the license file for details.
+   Source: https://github.com/spacehuhntech/WiFiDuck
+ */
+
+#include "tracer.h"
+
+#include "config.h"
+#include "debug.h"
+
+#include "keyboard.h"
+#include "spiffs.h"
+
+#define REPLAY_RECORDS 8 // Records of a trace that are read at once while replaying
+
+namespace tracer {
+    // ===== PRIVATE ===== //
+
+    // Reports that were sent, update() writes them to the file
+    File      out;
+    record_t* ring { NULL };
+    size_t    ringStart { 0 }; // Index of the oldest record
+    size_t    ringLen { 0 };   // Records in the ring
+    uint32_t  traceStart { 0 };
+    uint32_t  recorded { 0 };
+    uint32_t  dropped { 0 }; // Records that couldn't be written
+    bool      outError { false };
+
+    File     in;
+    String   replayName;
+    record_t replayBuf[REPLAY_RECORDS];
+    size_t   replayLen { 0 }; // Records in replayBuf
+    size_t   replayI { 0 };   // Next record of replayBuf
+    uint32_t replayStart { 0 };
+    uint32_t replayFirst { 0 }; // Time of the first record of the trace
+
+    // Writes the oldest records to the file
+    void flush(size_t n) {
+        while (n > 0) {
+            size_t part = _min(n, TRACE_SIZE - ringStart);
+            size_t size = part * sizeof(record_t);
+
+            if (out.write((uint8_t*)&ring[ringStart], size) != size) outError = true;
+
+            ringStart = (ringStart + part) % TRACE_SIZE;
+            ringLen  -= part;
+            n        -= part;
+        }
+    }
+
+    bool readRecords() {
+        replayLen = in.read((uint8_t*)replayBuf, sizeof(replayBuf)) / sizeof(record_t);
+        replayI   = 0;
+
+        return replayLen > 0;
+    }
+
+    // ===== PUBLIC ===== //
+    void start(String fileName) {
+        stop();
+
+        out = spiffs::openWrite(fileName);
+
+        if (!out) {
+            debugf("Couldn't open %s\n", fileName.c_str());
+            return;
+        }
+
+        ring = (record_t*)malloc(TRACE_SIZE * sizeof(record_t));
+
+        if (!ring) {
+            out.close();
+            return;
+        }
+
+        header_t h;
+
+        memcpy(h.magic, TRACE_MAGIC, sizeof(h.magic));
+        h.version = TRACE_VERSION;
+        memset(h.reserved, 0, sizeof(h.reserved));
+
+        outError   = out.write((uint8_t*)&h, sizeof(header_t)) != sizeof(header_t);
+        ringStart  = 0;
+        ringLen    = 0;
+        recorded   = 0;
+        dropped    = 0;
+        traceStart = micros();
+
+        debugf("Tracing reports to %s\n", fileName.c_str());
+    }
+
+    void stop() {
+        if (!ring) return;
+
+        flush(ringLen);
+        out.close();
+        spiffs::invalidate(); // The size of the trace changed since it was opened
+
+        free(ring);
+        ring = NULL;
+
+        if (outError) debugln("Couldn't write the whole trace");
+    }
+
+    bool tracing() {
+        return ring != NULL;
+    }
+
+    void record(const uint8_t* report) {
+        if (!ring) return;
+
+        // While a long string is typed, loop() doesn't get to update()
+        if (ringLen == TRACE_SIZE) flush(ringLen);
+
+        if (outError) {
+            ++dropped;
+            return;
+        }
+
+        record_t& r = ring[(ringStart + ringLen) % TRACE_SIZE];
+
+        r.time   = micros() - traceStart;
+        memcpy(r.report, report, TRACE_REPORT_SIZE);
+
+        ++ringLen;
+        ++recorded;
+    }
+
+    uint32_t getRecorded() {
+        return recorded;
+    }
+
+    uint32_t getDropped() {
+        return dropped;
+    }
+
+    void replay(String fileName) {
+        stopReplay();
+
+        in = spiffs::openRead(fileName);
+
+        header_t h;
+
+        if (!in || (in.read((uint8_t*)&h, sizeof(header_t)) != sizeof(header_t)) ||
+            (memcmp(h.magic, TRACE_MAGIC, sizeof(h.magic)) != 0) || (h.version != TRACE_VERSION) ||
+            !readRecords()) {
+            debugf("Invalid trace %s\n", fileName.c_str());
+            in.close();
+            return;
+        }
+
+        replayName  = fileName;
+        replayFirst = replayBuf[0].time;
+        replayStart = micros();
+
+        debugf("Replaying %s\n", fileName.c_str());
+    }
+
+    void stopReplay() {
+        if (!in) return;
+
+        in.close();
+        replayName = String();
+
+        // Don't leave a key pressed when the trace was stopped in the middle
+        keyboard::release();
+    }
+
+    bool replaying() {
+        return in ? true : false;
+    }
+
+    String currentReplay() {
+        return replayName;
+    }
+
+    void update() {
+        // Writing to SPIFFS takes a while, so it's done in bigger parts
+        if (ring && (ringLen >= TRACE_SIZE / 2)) flush(ringLen);
+
+        if (!in) return;
+
+        // Hand every report that is due to the queue, the queue keeps the pace of the UART
+        while ((micros() - replayStart) >= (replayBuf[replayI].time - replayFirst)) {
+            keyboard::send((keyboard::report*)replayBuf[replayI].report);
+
+            if ((++replayI == replayLen) && !readRecords()) {
+                in.close();
+                replayName = String();
+                return;
+            }
+        }
+    }
+}
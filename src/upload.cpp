@@ -0,0 +1,220 @@
+/*
+   This software is licensed under the MIT License. See the license file for details.
+   Source: https://github.com/spacehuhntech/WiFiDuck
+ */
+
+#include "upload.h"
+
+#include "config.h"
+#include "debug.h"
+
+#include "spiffs.h"
+#include "duckcompiler.h"
+#include "layouts.h"
+
+namespace upload {
+    // ===== PRIVATE ===== //
+    String   fileName;          // Empty when there's no upload
+    String   tmpName;           // Where the data goes until it's complete
+    uint32_t size { 0 };        // Size of the whole file
+    uint32_t crc { 0 };         // crc32 of the whole file
+    uint32_t received { 0 };    // Bytes in tmpName
+    uint32_t receivedCrc { 0 }; // crc32 of them
+    uint32_t client { 0 };      // Web socket client that sends the data
+
+    // Only open while connected
+    File     out;
+    uint8_t* frame { NULL }; // A chunk can arrive in more than one part
+
+    const uint32_t crcTable[16] = {
+        0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+        0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+    };
+
+    String ack() {
+        return "> ack " + String(received);
+    }
+
+    // Continues where a dropped connection left off
+    void resume() {
+        File    f = spiffs::openRead(tmpName);
+        uint8_t buf[256];
+        size_t  n;
+
+        received    = 0;
+        receivedCrc = 0;
+
+        while (f && ((n = f.read(buf, sizeof(buf))) > 0)) {
+            receivedCrc = crc32(buf, n, receivedCrc);
+            received   += n;
+        }
+
+        f.close();
+
+        if (received > size) {
+            received    = 0;
+            receivedCrc = 0;
+            out         = spiffs::openWrite(tmpName);
+        } else {
+            out = spiffs::openAppend(tmpName);
+        }
+    }
+
+    String finish() {
+        String res;
+
+        out.close();
+
+        if (receivedCrc == crc) {
+            // SPIFFS doesn't replace a file when renaming
+            if (!spiffs::rename(tmpName, fileName)) {
+                spiffs::remove(fileName);
+                spiffs::rename(tmpName, fileName);
+            }
+
+            duckcompiler::invalidate(fileName);
+            layouts::invalidate(fileName);
+            res = "> uploaded " + fileName;
+            debugf("Uploaded %s (%u bytes)\n", fileName.c_str(), size);
+        } else {
+            spiffs::remove(tmpName);
+            res = "> upload failed, crc32 of " + fileName + " doesn't match";
+        }
+
+        free(frame);
+        frame    = NULL;
+        fileName = String();
+
+        return res;
+    }
+
+    // ===== PUBLIC ===== //
+    String start(String fileName, uint32_t size, uint32_t crc, uint32_t client) {
+        if (!fileName.startsWith("/")) fileName = "/" + fileName;
+
+        // Only a paused upload can be taken over, the client of it might have reconnected
+        if (out && (client != upload::client)) return "ERROR: " + upload::fileName + " is uploaded by another client";
+
+        upload::client = client;
+
+        bool same = (fileName == upload::fileName) && (size == upload::size) && (crc == upload::crc);
+
+        if (!same) {
+            cancel();
+
+            if (size > spiffs::freeBytes()) return "ERROR: " + String(size) + " bytes don't fit";
+
+            upload::fileName = fileName;
+            upload::tmpName  = fileName + UPLOAD_EXTENSION;
+            upload::size     = size;
+            upload::crc      = crc;
+            received         = 0;
+            receivedCrc      = 0;
+
+            out = spiffs::openWrite(tmpName);
+        } else if (!out) {
+            resume();
+        }
+
+        if (!out) {
+            cancel();
+            return "ERROR: couldn't open " + fileName + UPLOAD_EXTENSION;
+        }
+
+        if (!frame) frame = (uint8_t*)malloc(UPLOAD_HEADER_SIZE + UPLOAD_CHUNK_SIZE);
+
+        if (!frame) {
+            pause();
+            return "ERROR: not enough memory";
+        }
+
+        if (received == size) return finish();
+
+        debugf("Upload of %s at %u/%u\n", fileName.c_str(), received, size);
+
+        return "> upload " + String(received) + " " + String(UPLOAD_WINDOW);
+    }
+
+    String receive(const uint8_t* data, size_t len, size_t index, size_t total, uint32_t client) {
+        if (!frame || !out || (client != upload::client)) return "ERROR: no upload";
+
+        if ((total < UPLOAD_HEADER_SIZE) || (total > UPLOAD_HEADER_SIZE + UPLOAD_CHUNK_SIZE) ||
+            (index + len > total)) return ack();
+
+        memcpy(&frame[index], data, len);
+
+        // Wait for the rest of the chunk
+        if (index + len < total) return String();
+
+        uint32_t offset, chunkCrc;
+
+        memcpy(&offset, &frame[1], sizeof(uint32_t));
+        memcpy(&chunkCrc, &frame[5], sizeof(uint32_t));
+
+        const uint8_t* chunk = &frame[UPLOAD_HEADER_SIZE];
+        size_t chunkLen      = total - UPLOAD_HEADER_SIZE;
+
+        if ((frame[0] != UPLOAD_MAGIC) || (offset != received) || (chunkLen > size - received) ||
+            (crc32(chunk, chunkLen) != chunkCrc)) return ack();
+
+        if (out.write(chunk, chunkLen) != chunkLen) {
+            String res = "ERROR: couldn't write " + tmpName;
+            cancel();
+            return res;
+        }
+
+        received   += chunkLen;
+        receivedCrc = crc32(chunk, chunkLen, receivedCrc);
+
+        if (received == size) return finish();
+
+        return ack();
+    }
+
+    // Keeps what was received, start() with the same file continues from there
+    void pause() {
+        out.close();
+        free(frame);
+        frame = NULL;
+    }
+
+    void cancel() {
+        if (!uploading()) return;
+
+        pause();
+        spiffs::remove(tmpName);
+        fileName = String();
+    }
+
+    bool uploading() {
+        return fileName.length() > 0;
+    }
+
+    String currentUpload() {
+        return fileName;
+    }
+
+    uint32_t getReceived() {
+        return received;
+    }
+
+    uint32_t getSize() {
+        return size;
+    }
+
+    uint32_t getClient() {
+        return client;
+    }
+
+    // Same as zlib, crc is the result of the previous part
+    uint32_t crc32(const uint8_t* data, size_t len, uint32_t crc) {
+        crc = ~crc;
+
+        for (size_t i = 0; i < len; ++i) {
+            crc = crcTable[(crc ^ data[i]) & 0x0F] ^ (crc >> 4);
+            crc = crcTable[(crc ^ (data[i] >> 4)) & 0x0F] ^ (crc >> 4);
+        }
+
+        return ~crc;
+    }
+}
@@ -16,6 +16,8 @@
 #include "debug.h"
 #include "cli.h"
 #include "spiffs.h"
+#include "upload.h"
+#include "protocol.h"
 #include "settings.h"
 
 #include "webfiles.h"
@@ -35,11 +37,105 @@ namespace webserver {
     AsyncEventSource events("/events");
 
     AsyncWebSocketClient* currentClient { nullptr };
+    uint32_t protocolClient { 0 }; // Client that uses the binary protocol
+    bool     requesting { false }; // The current frame of that client is a request
+    uint32_t pingClient { 0 };     // Client of the ping that wasn't answered yet
+    uint32_t pingTime { 0 };       // micros() of that ping
+    uint32_t roundTrip { 0 };      // Time until the last ping was answered (us)
 
     DNSServer dnsServer;
 
     bool reboot = false;
 
+    // Output of the CLI, it's written straight into a web socket frame
+    // that is sent when it's full or flushed. Without a client it's only debugged.
+    class FrameSink : public Print {
+        public:
+            AsyncWebSocketClient* client { nullptr };
+            uint8_t opcode { WS_TEXT }; // WS_BINARY for the binary protocol
+
+            size_t write(uint8_t c) override {
+                return write(&c, 1);
+            }
+
+            size_t write(const uint8_t* data, size_t len) override {
+                if (!client) {
+                    debugf("%.*s", (int)len, (const char*)data);
+                    return len;
+                }
+
+                size_t written = 0;
+
+                while (written < len) {
+                    if (!frame) frame = take();
+                    if (!frame) break;
+
+                    size_t n = _min(len - written, (size_t)(WS_FRAME_SIZE - frameLen));
+
+                    memcpy(frame->get() + frameLen, data + written, n);
+                    frameLen += n;
+                    written  += n;
+
+                    if (frameLen == WS_FRAME_SIZE) flush();
+                }
+
+                return written;
+            }
+
+            void flush() override {
+                if (!frame) return;
+
+                frame->setLength(frameLen);
+
+                if (opcode == WS_BINARY) {
+                    client->binary(frame);
+                } else {
+                    debugf("%.*s\n", (int)frameLen, (const char*)frame->get());
+                    client->text(frame);
+                }
+
+                // A frame that isn't pooled is deleted once it's sent
+                if (!pooled(frame)) frame->unlock();
+
+                frame    = nullptr;
+                frameLen = 0;
+            }
+
+        private:
+            AsyncWebSocketMessageBuffer* pool[WS_FRAME_POOL] { nullptr };
+            AsyncWebSocketMessageBuffer* frame { nullptr };
+            size_t frameLen { 0 };
+
+            bool pooled(AsyncWebSocketMessageBuffer* b) {
+                for (size_t i = 0; i < WS_FRAME_POOL; ++i) {
+                    if (pool[i] == b) return true;
+                }
+                return false;
+            }
+
+            // A frame of the pool that isn't being sent, or a new one when they all are.
+            // Frames are locked, so the web socket doesn't delete them
+            AsyncWebSocketMessageBuffer* take() {
+                for (size_t i = 0; i < WS_FRAME_POOL; ++i) {
+                    if (!pool[i]) {
+                        pool[i] = ws.makeBuffer(WS_FRAME_SIZE);
+                        if (pool[i]) pool[i]->lock();
+                    }
+
+                    if (pool[i] && (pool[i]->count() == 0)) return pool[i];
+                }
+
+                AsyncWebSocketMessageBuffer* b = ws.makeBuffer(WS_FRAME_SIZE);
+
+                if (b) b->lock();
+                else debugln("Not enough memory for a web socket frame");
+
+                return b;
+            }
+    };
+
+    FrameSink sink;
+
     void wsEvent(AsyncWebSocket* server, AsyncWebSocketClient* client, AwsEventType type, void* arg, uint8_t* data, size_t len) {
         if (type == WS_EVT_CONNECT) {
             debugf("WS Client connected %u\n", client->id());
@@ -47,6 +143,15 @@ namespace webserver {
 
         else if (type == WS_EVT_DISCONNECT) {
             debugf("WS Client disconnected %u\n", client->id());
+
+            // Free the memory of its upload until it's continued
+            if (client->id() == upload::getClient()) upload::pause();
+
+            if (client->id() == protocolClient) {
+                protocol::end();
+                protocolClient = 0;
+                requesting     = false;
+            }
         }
 
         else if (type == WS_EVT_ERROR) {
@@ -55,6 +160,11 @@ namespace webserver {
 
         else if (type == WS_EVT_PONG) {
             debugf("PONG %u\n", client->id());
+
+            if (client->id() == pingClient) {
+                roundTrip  = micros() - pingTime;
+                pingClient = 0;
+            }
         }
 
         else if (type == WS_EVT_DATA) {
@@ -67,12 +177,36 @@ namespace webserver {
                 debugf("Message from %u [%llu byte]=%s", client->id(), info->len, msg);
 
                 currentClient = client;
-                cli::parse(msg, [](const char* str) {
-                    webserver::send(str);
-                    debugf("%s\n", str);
-                }, false);
+                sink.client   = client;
+                cli::parse(msg, sink, false);
+                sink.client   = nullptr;
                 currentClient = nullptr;
             }
+
+            // A request of the binary protocol starts with its opcode, anything else is a chunk
+            // of an upload. Both can arrive in parts, so the first part decides about the rest
+            else if (info->opcode == WS_BINARY) {
+                if (info->index == 0) {
+                    bool request = (len > 0) && (data[0] != UPLOAD_MAGIC);
+
+                    if (request && (data[0] == PROTOCOL_HELLO)) protocolClient = client->id();
+
+                    if (client->id() == protocolClient) requesting = request;
+                    else if (request) return;
+                }
+
+                if ((client->id() == protocolClient) && requesting) {
+                    sink.client = client;
+                    sink.opcode = WS_BINARY;
+                    protocol::receive(data, len, info->index, info->len, sink);
+                    sink.opcode = WS_TEXT;
+                    sink.client = nullptr;
+                } else {
+                    String res = upload::receive(data, len, info->index, info->len, client->id());
+
+                    if (res.length() > 0) client->text(res);
+                }
+            }
         }
     }
 
@@ -103,9 +237,7 @@ namespace webserver {
 
             request->send(200, "text/plain", "Run: " + message);
 
-            cli::parse(message.c_str(), [](const char* str) {
-                debugf("%s\n", str);
-            }, false);
+            cli::parse(message.c_str(), sink, false);
         });
         server.on("/post", HTTP_POST, [](AsyncWebServerRequest *request){
             String message;
@@ -196,7 +328,46 @@ namespace webserver {
         dnsServer.processNextRequest();
     }
 
-    void send(const char* str) {
-        if (currentClient) currentClient->text(str);
+    uint32_t currentClientId() {
+        return currentClient ? currentClient->id() : 0;
+    }
+
+    void print(uint32_t clientId, OutputFunction f) {
+        AsyncWebSocketClient* client = nullptr;
+
+        if (clientId != 0) {
+            client = ws.client(clientId);
+
+            // It disconnected meanwhile
+            if (!client || (client->status() != WS_CONNECTED)) return;
+        }
+
+        sink.client = client;
+        f(sink);
+        sink.flush();
+        sink.client = nullptr;
+    }
+
+    // The answer arrives in the callback of the web socket,
+    // so it has to be waited for in loop() with pinging()
+    bool ping(uint32_t clientId) {
+        AsyncWebSocketClient* client = ws.client(clientId);
+
+        if (!client || (client->status() != WS_CONNECTED)) return false;
+
+        pingClient = clientId;
+        pingTime   = micros();
+        roundTrip  = 0;
+        client->ping();
+
+        return true;
+    }
+
+    bool pinging() {
+        return pingClient != 0;
+    }
+
+    uint32_t getRoundTrip() {
+        return roundTrip;
     }
 }
\ No newline at end of file
@@ -0,0 +1,159 @@
+/*
+   This software is licensed under the MIT License. See the license file for details.
+   Source: https://github.com/spacehuhntech/WiFiDuck
+ */
+
+// Compiled scripts have to type exactly what the interpreter types,
+// also when they're resumed at a line, run with:
+//   pio test -e native -f test_duckscript
+
+#include <Arduino.h>
+#include <unity.h>
+
+#include "duckcompiler.h"
+#include "duckscript.h"
+#include "keyboard.h"
+#include "spiffs.h"
+
+#include <string> // std::string
+
+#define COMPILED "/compiled.txt"
+#define INTERPRETED "/interpreted.txt"
+
+// REPEAT, a line that doesn't fit into the buffer of the reader, a blank line and a \r\n line break
+const char script[] =
+    "REM equivalence\n"
+    "DEFAULTDELAY 5\n"
+    "STRING Hello\n"
+    "ENTER\n"
+    "REPEAT 2\n"
+    "LOCALE DE\n"
+    "STRING yz \xC3\xA4\xC3\xB6\xC3\xBC\n"
+    "REPEAT 3\n"
+    "\n"
+    "CTRL ALT DELETE\r\n"
+    "STRING 0123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789"
+    "0123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789"
+    "0123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789"
+    "0123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789\n"
+    "LOCALE US\n"
+    "DELAY 10\n"
+    "GUI r\n"
+    "STRING done\n"
+    "REPEAT 2\n";
+
+const uint32_t lines = 16;
+
+// Runs a script until all of its reports are sent, without waiting for any DELAY
+std::string run(const char* fileName, uint32_t line = 1) {
+    keyboard::setLocale(&locale_us);
+    Serial.clear();
+
+    duckscript::run(fileName, line);
+
+    while (duckscript::isRunning() || (keyboard::queued() > 0)) {
+        unsigned int idle = duckscript::idleTime();
+
+        native::advanceTime(idle > 0 ? idle : 1);
+        keyboard::update();
+        duckscript::nextLine();
+    }
+
+    return Serial.captured;
+}
+
+// spiffs::write() appends
+void create(const char* fileName, const char* str, size_t len) {
+    spiffs::remove(fileName);
+    spiffs::write(fileName, (const uint8_t*)str, len);
+}
+
+void setUp() {}
+
+void tearDown() {}
+
+void test_compiles() {
+    run(COMPILED);
+
+    TEST_ASSERT_TRUE(spiffs::exists(duckcompiler::codeName(COMPILED)));
+    TEST_ASSERT_TRUE(spiffs::exists(duckcompiler::indexName(COMPILED)));
+    TEST_ASSERT_FALSE(spiffs::exists(duckcompiler::indexName(INTERPRETED)));
+}
+
+void test_same_reports() {
+    std::string interpreted = run(INTERPRETED);
+    std::string compiled    = run(COMPILED);
+
+    TEST_ASSERT_TRUE(interpreted.size() > 0);
+    TEST_ASSERT_EQUAL(interpreted.size(), compiled.size());
+    TEST_ASSERT_TRUE(interpreted == compiled);
+
+    // The compiled code is used again
+    TEST_ASSERT_TRUE(run(COMPILED) == compiled);
+}
+
+void test_repeat() {
+    const char repeated[] = "STRING ab\nREPEAT 4\n";
+    const char unrolled[] = "STRING ab\nSTRING ab\nSTRING ab\nSTRING ab\nSTRING ab\n";
+
+    create("/repeated.txt", repeated, sizeof(repeated) - 1);
+    create("/unrolled.txt", unrolled, sizeof(unrolled) - 1);
+
+    TEST_ASSERT_TRUE(run("/repeated.txt") == run("/unrolled.txt"));
+}
+
+void test_line_index() {
+    run(COMPILED);
+
+    uint32_t prev = 0;
+
+    for (uint32_t line = 1; line <= lines; ++line) {
+        uint32_t offset = duckcompiler::lineOffset(COMPILED, line);
+
+        TEST_ASSERT_TRUE(offset != DUCKC_NO_LINE);
+        TEST_ASSERT_TRUE(offset >= prev);
+        TEST_ASSERT_TRUE(duckcompiler::lineAt(COMPILED, offset) >= line);
+
+        prev = offset;
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(DUCKC_NO_LINE, duckcompiler::lineOffset(COMPILED, 0));
+    TEST_ASSERT_EQUAL_UINT32(DUCKC_NO_LINE, duckcompiler::lineOffset(COMPILED, lines + 1));
+}
+
+void test_resume() {
+    for (uint32_t line = 1; line <= lines; ++line) {
+        std::string interpreted = run(INTERPRETED, line);
+        std::string compiled    = run(COMPILED, line);
+
+        char msg[32];
+        snprintf(msg, sizeof(msg), "line %u", (unsigned int)line);
+
+        TEST_ASSERT_EQUAL_MESSAGE(interpreted.size(), compiled.size(), msg);
+        TEST_ASSERT_TRUE_MESSAGE(interpreted == compiled, msg);
+    }
+
+    // Nothing is typed from a line that doesn't exist
+    TEST_ASSERT_TRUE(run(COMPILED, lines + 1).empty());
+    TEST_ASSERT_FALSE(duckscript::isRunning());
+}
+
+int main() {
+    spiffs::begin();
+    keyboard::begin();
+
+    create(COMPILED, script, sizeof(script) - 1);
+    create(INTERPRETED, script, sizeof(script) - 1);
+
+    // A directory where the code would go makes compiling fail,
+    // so the script is interpreted like when the flash is full
+    create("/interpreted.duckc/blocked", "", 0);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_compiles);
+    RUN_TEST(test_same_reports);
+    RUN_TEST(test_repeat);
+    RUN_TEST(test_line_index);
+    RUN_TEST(test_resume);
+    return UNITY_END();
+}
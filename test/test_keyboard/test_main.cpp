@@ -0,0 +1,93 @@
+/*
+   This software is licensed under the MIT License. See the license file for details.
+   Source: https://github.com/spacehuhntech/WiFiDuck
+ */
+
+// Strings that are too long for the cache are encoded in parts,
+// but they're only released once, the same as a cached string, run with:
+//   pio test -e native -f test_keyboard
+
+#include <Arduino.h>
+#include <unity.h>
+
+#include "config.h"
+#include "keyboard.h"
+
+#include <string> // std::string
+
+// Every report that's sent while typing str
+std::string type(const std::string& str, bool optimize) {
+    keyboard::setOptimize(optimize);
+    keyboard::clearCache();
+    Serial.clear();
+
+    keyboard::write(str.c_str(), str.length());
+    keyboard::flush();
+
+    return Serial.captured;
+}
+
+// Number of reports that release all keys
+size_t releases(const std::string& reports) {
+    const keyboard::report empty = { KEY_NONE, KEY_NONE, { KEY_NONE, KEY_NONE, KEY_NONE, KEY_NONE, KEY_NONE, KEY_NONE } };
+    size_t n = 0;
+
+    for (size_t i = 0; i + sizeof(keyboard::report) <= reports.length(); i += sizeof(keyboard::report)) {
+        if (memcmp(&reports[i], &empty, sizeof(keyboard::report)) == 0) ++n;
+    }
+
+    return n;
+}
+
+void setUp() {
+    keyboard::setLocale(&locale_us);
+}
+
+void tearDown() {
+    keyboard::setOptimize(KEYBOARD_OPTIMIZE);
+}
+
+// Too long for the cache, so it's encoded in parts
+void test_uncached_release() {
+    std::string str;
+
+    while (str.length() < KEYBOARD_CACHE_SIZE) str += "abcdefghijklmnopqrstuvwxyz";
+
+    std::string reports = type(str, true);
+
+    TEST_ASSERT_EQUAL_UINT32((str.length() + 1) * sizeof(keyboard::report), reports.length());
+    TEST_ASSERT_EQUAL_UINT32(1, releases(reports));
+}
+
+// A key that's typed twice is released in between, also across the parts
+void test_uncached_repeat() {
+    std::string str(KEYBOARD_CACHE_SIZE, 'a');
+
+    std::string reports = type(str, true);
+
+    TEST_ASSERT_EQUAL_UINT32(str.length() * 2 * sizeof(keyboard::report), reports.length());
+    TEST_ASSERT_EQUAL_UINT32(str.length(), releases(reports));
+}
+
+void test_uncached_unoptimized() {
+    std::string str;
+
+    while (str.length() < KEYBOARD_CACHE_SIZE) str += "abcdefghijklmnopqrstuvwxyz";
+
+    std::string reports = type(str, false);
+
+    TEST_ASSERT_EQUAL_UINT32(str.length() * 2 * sizeof(keyboard::report), reports.length());
+    TEST_ASSERT_EQUAL_UINT32(str.length(), releases(reports));
+}
+
+int main(int argc, char** argv) {
+    keyboard::begin();
+
+    UNITY_BEGIN();
+
+    RUN_TEST(test_uncached_release);
+    RUN_TEST(test_uncached_repeat);
+    RUN_TEST(test_uncached_unoptimized);
+
+    return UNITY_END();
+}
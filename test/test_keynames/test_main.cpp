@@ -0,0 +1,147 @@
+/*
+   This software is licensed under the MIT License. See the license file for details.
+   Source: https://github.com/spacehuhntech/WiFiDuck
+ */
+
+// Every key name of the perfect hash table in include/keynames.h
+// has to be found by the parser, run with:
+//   pio test -e native -f test_keynames
+
+#include <Arduino.h>
+#include <unity.h>
+
+#include "duckparser.h"
+#include "keynames.h"
+
+#include <ctype.h> // tolower
+
+typedef struct pressed_t {
+    uint8_t items[8];
+    size_t  len;
+    size_t  instructions;
+} pressed_t;
+
+pressed_t pressed;
+
+void emitPress(uint8_t code, const uint8_t* data, size_t len) {
+    ++pressed.instructions;
+
+    if (((code & ~OP_FLAG_DELAY) != OP_PRESS) || (len > sizeof(pressed.items))) return;
+
+    memcpy(pressed.items, data, len);
+    pressed.len = len;
+}
+
+// Compiles a line with only the name and returns the press item it became
+pressed_t press(const char* name, size_t len) {
+    char line[32];
+
+    memcpy(line, name, len);
+    line[len] = '\n';
+
+    pressed = pressed_t {};
+
+    duckparser::reset();
+    duckparser::compile(line, len + 1, emitPress);
+
+    return pressed;
+}
+
+void assertKey(const char* name, size_t len, uint8_t key, uint8_t modifiers) {
+    pressed_t p = press(name, len);
+
+    char msg[48];
+    snprintf(msg, sizeof(msg), "%.*s", (int)len, name);
+
+    TEST_ASSERT_EQUAL_MESSAGE(1, p.instructions, msg);
+    TEST_ASSERT_EQUAL_MESSAGE(2, p.len, msg);
+
+    if (key != KEY_NONE) {
+        TEST_ASSERT_EQUAL_HEX8_MESSAGE(PRESS_KEY, p.items[0], msg);
+        TEST_ASSERT_EQUAL_HEX8_MESSAGE(key, p.items[1], msg);
+    } else {
+        TEST_ASSERT_EQUAL_HEX8_MESSAGE(PRESS_MOD, p.items[0], msg);
+        TEST_ASSERT_EQUAL_HEX8_MESSAGE(modifiers, p.items[1], msg);
+    }
+}
+
+void setUp() {}
+
+void tearDown() {}
+
+void test_every_name() {
+    for (size_t i = 0; i < KEYNAMES_LEN; ++i) {
+        const keyname_t& k = keynames[i];
+
+        assertKey(&keynames_pool[k.name], k.name_len, k.key, k.modifiers);
+    }
+}
+
+void test_lowercase() {
+    for (size_t i = 0; i < KEYNAMES_LEN; ++i) {
+        const keyname_t& k = keynames[i];
+        char name[32];
+
+        for (size_t j = 0; j < k.name_len; ++j) name[j] = tolower(keynames_pool[k.name + j]);
+
+        assertKey(name, k.name_len, k.key, k.modifiers);
+    }
+}
+
+// The aliases of scripts/keynames.py
+void test_aliases() {
+    assertKey("ENTER", 5, KEY_ENTER, KEY_NONE);
+    assertKey("MENU", 4, KEY_PROPS, KEY_NONE);
+    assertKey("APP", 3, KEY_PROPS, KEY_NONE);
+    assertKey("DELETE", 6, KEY_BACKSPACE, KEY_NONE);
+    assertKey("HOME", 4, KEY_HOME, KEY_NONE);
+    assertKey("INSERT", 6, KEY_INSERT, KEY_NONE);
+    assertKey("PAGEUP", 6, KEY_PAGEUP, KEY_NONE);
+    assertKey("PAGEDOWN", 8, KEY_PAGEDOWN, KEY_NONE);
+    assertKey("UPARROW", 7, KEY_UP, KEY_NONE);
+    assertKey("UP", 2, KEY_UP, KEY_NONE);
+    assertKey("DOWNARROW", 9, KEY_DOWN, KEY_NONE);
+    assertKey("DOWN", 4, KEY_DOWN, KEY_NONE);
+    assertKey("LEFTARROW", 9, KEY_LEFT, KEY_NONE);
+    assertKey("LEFT", 4, KEY_LEFT, KEY_NONE);
+    assertKey("RIGHTARROW", 10, KEY_RIGHT, KEY_NONE);
+    assertKey("RIGHT", 5, KEY_RIGHT, KEY_NONE);
+    assertKey("TAB", 3, KEY_TAB, KEY_NONE);
+    assertKey("END", 3, KEY_END, KEY_NONE);
+    assertKey("ESC", 3, KEY_ESC, KEY_NONE);
+    assertKey("ESCAPE", 6, KEY_ESC, KEY_NONE);
+    assertKey("SPACE", 5, KEY_SPACE, KEY_NONE);
+    assertKey("PAUSE", 5, KEY_PAUSE, KEY_NONE);
+    assertKey("BREAK", 5, KEY_PAUSE, KEY_NONE);
+    assertKey("CAPSLOCK", 8, KEY_CAPSLOCK, KEY_NONE);
+    assertKey("NUMLOCK", 7, KEY_NUMLOCK, KEY_NONE);
+    assertKey("PRINTSCREEN", 11, KEY_SYSRQ, KEY_NONE);
+    assertKey("SCROLLLOCK", 10, KEY_SCROLLLOCK, KEY_NONE);
+
+    assertKey("CTRL", 4, KEY_NONE, KEY_MOD_LCTRL);
+    assertKey("CONTROL", 7, KEY_NONE, KEY_MOD_LCTRL);
+    assertKey("SHIFT", 5, KEY_NONE, KEY_MOD_LSHIFT);
+    assertKey("ALT", 3, KEY_NONE, KEY_MOD_LALT);
+    assertKey("WINDOWS", 7, KEY_NONE, KEY_MOD_LMETA);
+    assertKey("GUI", 3, KEY_NONE, KEY_MOD_LMETA);
+}
+
+// Anything else is a character for the locale
+void test_unknown() {
+    const char* names[] = { "ENTE", "ENTERR", "F25", "KEY_ENTER", "NONE", "ERR_OVF" };
+
+    for (const char* name : names) {
+        pressed_t p = press(name, strlen(name));
+
+        TEST_ASSERT_EQUAL_HEX8_MESSAGE(PRESS_CHAR, p.items[0], name);
+    }
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_every_name);
+    RUN_TEST(test_lowercase);
+    RUN_TEST(test_aliases);
+    RUN_TEST(test_unknown);
+    return UNITY_END();
+}
@@ -0,0 +1,111 @@
+/*
+   This software is licensed under the MIT License. See the license file for details.
+   Source: https://github.com/spacehuhntech/WiFiDuck
+ */
+
+// bench/payloads/notepad.txt compressed by scripts/compress.py with the default
+// window and lookahead (-w 8 -l 4), the largest (-w 10 -l 5) and the smallest (-w 4 -l 3)
+
+#pragma once
+
+#include <stdint.h> // uint8_t
+
+const uint8_t script[] = {
+    0x52, 0x45, 0x4D, 0x20, 0x57, 0x72, 0x69, 0x74, 0x65, 0x73, 0x20, 0x61, 0x20, 0x73, 0x68, 0x6F,
+    0x72, 0x74, 0x20, 0x6C, 0x65, 0x74, 0x74, 0x65, 0x72, 0x20, 0x69, 0x6E, 0x74, 0x6F, 0x20, 0x6E,
+    0x6F, 0x74, 0x65, 0x70, 0x61, 0x64, 0x0A, 0x47, 0x55, 0x49, 0x20, 0x72, 0x0A, 0x44, 0x45, 0x4C,
+    0x41, 0x59, 0x20, 0x33, 0x30, 0x30, 0x0A, 0x53, 0x54, 0x52, 0x49, 0x4E, 0x47, 0x20, 0x6E, 0x6F,
+    0x74, 0x65, 0x70, 0x61, 0x64, 0x0A, 0x45, 0x4E, 0x54, 0x45, 0x52, 0x0A, 0x44, 0x45, 0x4C, 0x41,
+    0x59, 0x20, 0x38, 0x30, 0x30, 0x0A, 0x53, 0x54, 0x52, 0x49, 0x4E, 0x47, 0x20, 0x44, 0x65, 0x61,
+    0x72, 0x20, 0x72, 0x65, 0x61, 0x64, 0x65, 0x72, 0x2C, 0x0A, 0x45, 0x4E, 0x54, 0x45, 0x52, 0x0A,
+    0x45, 0x4E, 0x54, 0x45, 0x52, 0x0A, 0x53, 0x54, 0x52, 0x49, 0x4E, 0x47, 0x20, 0x74, 0x68, 0x69,
+    0x73, 0x20, 0x74, 0x65, 0x78, 0x74, 0x20, 0x77, 0x61, 0x73, 0x20, 0x74, 0x79, 0x70, 0x65, 0x64,
+    0x20, 0x62, 0x79, 0x20, 0x61, 0x20, 0x57, 0x69, 0x46, 0x69, 0x20, 0x44, 0x75, 0x63, 0x6B, 0x20,
+    0x74, 0x6F, 0x20, 0x6D, 0x65, 0x61, 0x73, 0x75, 0x72, 0x65, 0x20, 0x68, 0x6F, 0x77, 0x20, 0x66,
+    0x61, 0x73, 0x74, 0x20, 0x70, 0x6C, 0x61, 0x69, 0x6E, 0x20, 0x74, 0x65, 0x78, 0x74, 0x20, 0x72,
+    0x65, 0x61, 0x63, 0x68, 0x65, 0x73, 0x20, 0x74, 0x68, 0x65, 0x20, 0x68, 0x6F, 0x73, 0x74, 0x2E,
+    0x0A, 0x45, 0x4E, 0x54, 0x45, 0x52, 0x0A, 0x53, 0x54, 0x52, 0x49, 0x4E, 0x47, 0x20, 0x54, 0x68,
+    0x65, 0x20, 0x71, 0x75, 0x69, 0x63, 0x6B, 0x20, 0x62, 0x72, 0x6F, 0x77, 0x6E, 0x20, 0x66, 0x6F,
+    0x78, 0x20, 0x6A, 0x75, 0x6D, 0x70, 0x73, 0x20, 0x6F, 0x76, 0x65, 0x72, 0x20, 0x74, 0x68, 0x65,
+    0x20, 0x6C, 0x61, 0x7A, 0x79, 0x20, 0x64, 0x6F, 0x67, 0x2E, 0x20, 0x30, 0x31, 0x32, 0x33, 0x34,
+    0x35, 0x36, 0x37, 0x38, 0x39, 0x0A, 0x45, 0x4E, 0x54, 0x45, 0x52, 0x0A, 0x53, 0x54, 0x52, 0x49,
+    0x4E, 0x47, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28, 0x29, 0x2A, 0x2B, 0x2C, 0x2D,
+    0x2E, 0x2F, 0x3A, 0x3B, 0x3C, 0x3D, 0x3E, 0x3F, 0x40, 0x5B, 0x5C, 0x5D, 0x5E, 0x5F, 0x60, 0x7B,
+    0x7C, 0x7D, 0x7E, 0x0A, 0x45, 0x4E, 0x54, 0x45, 0x52, 0x0A, 0x43, 0x54, 0x52, 0x4C, 0x20, 0x73,
+    0x0A, 0x44, 0x45, 0x4C, 0x41, 0x59, 0x20, 0x33, 0x30, 0x30, 0x0A, 0x53, 0x54, 0x52, 0x49, 0x4E,
+    0x47, 0x20, 0x6C, 0x65, 0x74, 0x74, 0x65, 0x72, 0x2E, 0x74, 0x78, 0x74, 0x0A, 0x45, 0x4E, 0x54,
+    0x45, 0x52, 0x0A,
+};
+
+const uint8_t duckz_w8_l4[] = {
+    0x44, 0x55, 0x4B, 0x5A, 0x01, 0x08, 0x04, 0x00, 0x73, 0x01, 0x00, 0x00, 0xA9, 0x51, 0x69, 0xB2,
+    0x0A, 0xBD, 0xCA, 0xD3, 0x74, 0xB2, 0xDC, 0xE4, 0x16, 0x19, 0x05, 0xCE, 0xD1, 0x6F, 0xB9, 0x5D,
+    0x24, 0x16, 0xCB, 0x2D, 0xD0, 0x1C, 0x37, 0x29, 0x05, 0xA6, 0xDD, 0x74, 0xB7, 0xC8, 0x2D, 0xD6,
+    0xF0, 0x50, 0xDC, 0x2C, 0x36, 0x48, 0x55, 0x1E, 0xAB, 0x49, 0x90, 0x5C, 0xA1, 0x54, 0x4A, 0x2D,
+    0x32, 0x83, 0x59, 0x90, 0x4C, 0xE6, 0x13, 0x08, 0x55, 0x4E, 0xA9, 0x52, 0xA4, 0xD3, 0xA8, 0xE1,
+    0xE8, 0xA2, 0xD3, 0xAA, 0x94, 0x5A, 0x90, 0x79, 0xA7, 0x01, 0xE9, 0xA2, 0x59, 0x6C, 0x24, 0x71,
+    0xB9, 0x01, 0x06, 0xC8, 0x4E, 0x19, 0x60, 0x8D, 0x80, 0xAA, 0x1F, 0x6B, 0xA5, 0xA2, 0xD2, 0x76,
+    0x12, 0x08, 0xDE, 0x0E, 0x63, 0x77, 0xB0, 0x82, 0x0A, 0xF3, 0x70, 0xB2, 0xD9, 0x24, 0x16, 0x2B,
+    0xCA, 0x20, 0xAA, 0xF6, 0x9A, 0x35, 0xA4, 0x7A, 0x37, 0x5B, 0x1D, 0xAC, 0x28, 0x28, 0x31, 0xB6,
+    0x90, 0x06, 0xE7, 0x75, 0x22, 0x8C, 0x81, 0x38, 0x37, 0x79, 0x05, 0x98, 0x14, 0x22, 0xC1, 0xB8,
+    0x5B, 0x2C, 0x29, 0xC1, 0x1B, 0xA9, 0x70, 0xAC, 0x76, 0x85, 0xD9, 0x12, 0x44, 0x3E, 0x61, 0xB1,
+    0x97, 0x18, 0x36, 0xA8, 0x16, 0x2B, 0x8D, 0xD6, 0xD2, 0x47, 0x2B, 0x15, 0xC8, 0x7A, 0x23, 0x31,
+    0xB3, 0x5B, 0xEF, 0x12, 0x0B, 0x55, 0xD6, 0xDB, 0x70, 0x18, 0x0D, 0xBE, 0xEC, 0xE2, 0x21, 0xA9,
+    0x92, 0xC6, 0xF4, 0x71, 0x1B, 0x25, 0xBE, 0xCF, 0x2E, 0x90, 0x4C, 0x26, 0x33, 0x29, 0x9C, 0xD2,
+    0x6B, 0x36, 0x9B, 0xCE, 0x27, 0x24, 0x4D, 0x90, 0xC8, 0xA4, 0x72, 0x49, 0x2C, 0x9A, 0x4F, 0x28,
+    0x94, 0xCA, 0xA5, 0x72, 0xC9, 0x6C, 0xBA, 0x5F, 0x3A, 0x9D, 0xCF, 0x27, 0xB3, 0xE9, 0xFD, 0x02,
+    0xB7, 0x5C, 0xAE, 0xD7, 0xAB, 0xF6, 0x0B, 0xDD, 0xF2, 0xFB, 0x7E, 0x16, 0xB5, 0x0C, 0x5A, 0x34,
+    0xC9, 0x05, 0xCE, 0x15, 0x44, 0xA2, 0xD3, 0x28, 0x35, 0x99, 0x04, 0xCE, 0x61, 0x30, 0x1F, 0x3D,
+    0xB2, 0xCB, 0x74, 0x55, 0x0D, 0xCA, 0x5D, 0x74, 0x56, 0x88, 0xA1, 0x80,
+};
+
+const uint8_t duckz_w10_l5[] = {
+    0x44, 0x55, 0x4B, 0x5A, 0x01, 0x0A, 0x05, 0x00, 0x73, 0x01, 0x00, 0x00, 0xA9, 0x51, 0x69, 0xB2,
+    0x0A, 0xBD, 0xCA, 0xD3, 0x74, 0xB2, 0xDC, 0xE4, 0x16, 0x19, 0x05, 0xCE, 0xD1, 0x6F, 0xB9, 0x5D,
+    0x24, 0x16, 0xCB, 0x2D, 0xD0, 0x07, 0x06, 0xE5, 0x20, 0xB4, 0xDB, 0xAE, 0x96, 0xF9, 0x05, 0xBA,
+    0xDE, 0x02, 0x83, 0x70, 0xB0, 0xD9, 0x21, 0x54, 0x7A, 0xAD, 0x26, 0x41, 0x72, 0x85, 0x51, 0x28,
+    0xB4, 0xCA, 0x0D, 0x66, 0x41, 0x33, 0x98, 0x4C, 0x21, 0x55, 0x3A, 0xA5, 0x4A, 0x93, 0x4E, 0xA3,
+    0x81, 0xE4, 0x51, 0x69, 0xD5, 0x4A, 0x2D, 0x48, 0x0F, 0x1A, 0x70, 0x07, 0x93, 0x44, 0xB2, 0xD8,
+    0x42, 0x38, 0x6E, 0x40, 0x10, 0x36, 0x40, 0x9C, 0x19, 0x60, 0x23, 0x30, 0x05, 0x28, 0x1F, 0x35,
+    0xD2, 0xD1, 0x69, 0x0E, 0xC1, 0x08, 0x21, 0xBC, 0x07, 0x30, 0xDD, 0xEC, 0x20, 0x20, 0x57, 0x9B,
+    0x85, 0x96, 0xC9, 0x20, 0xB1, 0x5E, 0x44, 0x40, 0xAA, 0xF6, 0x9A, 0x35, 0xA4, 0x1E, 0x86, 0xEB,
+    0x63, 0xB5, 0x81, 0x40, 0x88, 0x30, 0xDB, 0x42, 0x00, 0x6E, 0x77, 0x50, 0x8A, 0x19, 0x00, 0x9C,
+    0x0D, 0xDE, 0x41, 0x66, 0x01, 0x41, 0x05, 0x81, 0xB8, 0x5B, 0x2C, 0x22, 0x70, 0x20, 0xDC, 0xA1,
+    0x70, 0x56, 0x3B, 0x40, 0xBB, 0x10, 0x49, 0x08, 0x1F, 0x18, 0x1B, 0x0C, 0xB8, 0x30, 0x36, 0xA8,
+    0x05, 0x85, 0x71, 0xBA, 0xDA, 0x42, 0x38, 0xAC, 0x57, 0x20, 0x7A, 0x10, 0x66, 0x1B, 0x35, 0xBE,
+    0xF1, 0x20, 0xB5, 0x5D, 0x6D, 0xB7, 0x00, 0x60, 0x1B, 0x7D, 0xD8, 0x71, 0x08, 0x1A, 0x8C, 0x25,
+    0x86, 0xF4, 0x1C, 0x43, 0x64, 0xB7, 0xD9, 0xE5, 0xD2, 0x09, 0x84, 0xC6, 0x65, 0x33, 0x9A, 0x4D,
+    0x66, 0xD3, 0x79, 0xC4, 0xE4, 0x22, 0x36, 0x43, 0x22, 0x91, 0xC9, 0x24, 0xB2, 0x69, 0x3C, 0xA2,
+    0x53, 0x2A, 0x95, 0xCB, 0x25, 0xB2, 0xE9, 0x7C, 0xEA, 0x77, 0x3C, 0x9E, 0xCF, 0xA7, 0xF4, 0x0A,
+    0xDD, 0x72, 0xBB, 0x5E, 0xAF, 0xD8, 0x2F, 0x77, 0xCB, 0xED, 0xF8, 0x16, 0x9A, 0x86, 0x0B, 0x43,
+    0x4C, 0x28, 0x21, 0x24, 0x71, 0x29, 0xC5, 0x97, 0x5D, 0x05, 0x68, 0x41, 0x41, 0x80,
+};
+
+const uint8_t duckz_w4_l3[] = {
+    0x44, 0x55, 0x4B, 0x5A, 0x01, 0x04, 0x03, 0x00, 0x73, 0x01, 0x00, 0x00, 0xA9, 0x51, 0x69, 0xB2,
+    0x0A, 0xBD, 0xCA, 0xD3, 0x74, 0xB2, 0xDC, 0xE4, 0x16, 0x19, 0x05, 0xCE, 0xD1, 0x6F, 0xB9, 0x5D,
+    0x24, 0x16, 0xCB, 0x2D, 0xD1, 0xC6, 0xE5, 0x20, 0xB4, 0xDB, 0xAE, 0x96, 0xF9, 0x05, 0xBA, 0xDE,
+    0xA3, 0x70, 0xB0, 0xD9, 0x21, 0x54, 0x7A, 0xAD, 0x26, 0x41, 0x72, 0x85, 0x51, 0x28, 0xB4, 0xCA,
+    0x0D, 0x66, 0x41, 0x33, 0x98, 0x4C, 0x21, 0x55, 0x3A, 0xA5, 0x4A, 0x93, 0x4E, 0xA3, 0xC8, 0x2D,
+    0xD6, 0xFB, 0xA5, 0x96, 0xE1, 0x61, 0xB2, 0x42, 0xA8, 0xB4, 0xEA, 0xA5, 0x16, 0xA5, 0x0A, 0xA2,
+    0x51, 0x69, 0x94, 0x1A, 0xCC, 0x82, 0x71, 0x30, 0x98, 0x42, 0xAA, 0x75, 0x4A, 0x95, 0x26, 0x9D,
+    0x47, 0x90, 0x51, 0x2C, 0xB6, 0x1B, 0x94, 0x82, 0xE4, 0x43, 0x64, 0xB2, 0xDC, 0xA5, 0x90, 0xAA,
+    0x2D, 0x3A, 0xA9, 0x45, 0xA9, 0x17, 0x54, 0xEA, 0x95, 0x2A, 0x4D, 0x3A, 0x8F, 0x20, 0xBA, 0x5A,
+    0x2D, 0x37, 0x32, 0x1B, 0x2D, 0xE2, 0xE9, 0x20, 0xBB, 0xD8, 0x50, 0xAF, 0x37, 0x0B, 0x2D, 0x92,
+    0x41, 0x62, 0xBC, 0xC8, 0x2C, 0x32, 0x0A, 0xBD, 0xA6, 0x8D, 0x69, 0x90, 0x51, 0x2E, 0xB6, 0x3B,
+    0x5C, 0x82, 0xE9, 0x6F, 0x90, 0x5B, 0x6C, 0xB6, 0x1B, 0x9D, 0xD6, 0xE5, 0x65, 0x90, 0x5A, 0x2D,
+    0xF7, 0x79, 0x05, 0x99, 0x46, 0xE9, 0x20, 0xB8, 0x5B, 0x2C, 0x36, 0x9B, 0x74, 0x82, 0xE9, 0x65,
+    0xBC, 0x28, 0xDC, 0xAC, 0xB6, 0x1B, 0x1D, 0xA2, 0xCB, 0x73, 0x61, 0x21, 0x90, 0x5A, 0x2D, 0xF7,
+    0x3B, 0xA4, 0xBA, 0x15, 0x45, 0xA7, 0x55, 0x28, 0xB5, 0x28, 0x55, 0x4E, 0xA9, 0x52, 0xA4, 0xD3,
+    0xA8, 0xF2, 0x0A, 0xA5, 0xA2, 0xCB, 0x20, 0xB8, 0xDD, 0x6D, 0x36, 0x3B, 0x5C, 0x82, 0xC5, 0x72,
+    0xB7, 0xDD, 0xED, 0xD2, 0x0B, 0x35, 0xBE, 0xF1, 0x20, 0xB5, 0x5D, 0x6D, 0xB7, 0x0B, 0x9C, 0x82,
+    0xDF, 0x76, 0xB2, 0xDC, 0xA4, 0x17, 0x4B, 0x45, 0x96, 0x41, 0x6C, 0xB0, 0xDE, 0xAF, 0x32, 0x0B,
+    0x25, 0xBE, 0xCF, 0x2E, 0x90, 0x4C, 0x26, 0x33, 0x29, 0x9C, 0xD2, 0x6B, 0x36, 0x9B, 0xCE, 0x27,
+    0x30, 0xAA, 0x2D, 0x3A, 0xA9, 0x45, 0xA9, 0x42, 0xAA, 0x75, 0x4A, 0x95, 0x26, 0x9D, 0x47, 0x90,
+    0x48, 0x64, 0x52, 0x39, 0x24, 0x96, 0x4D, 0x27, 0x94, 0x4A, 0x65, 0x52, 0xB9, 0x64, 0xB6, 0x5D,
+    0x2F, 0x9D, 0x4E, 0xE7, 0x93, 0xD9, 0xF4, 0xFE, 0x81, 0x5B, 0xAE, 0x57, 0x6B, 0xD5, 0xFB, 0x05,
+    0xEE, 0xF9, 0x7D, 0xBF, 0x42, 0xA8, 0xB4, 0xEA, 0xA5, 0x16, 0xA5, 0x0A, 0xA1, 0xD5, 0x2A, 0x54,
+    0xC9, 0x05, 0xCE, 0x15, 0x44, 0xA2, 0xD3, 0x28, 0x35, 0x99, 0x04, 0xCE, 0x61, 0x30, 0x85, 0x54,
+    0xEA, 0x95, 0x2A, 0x4D, 0x3A, 0x8F, 0x20, 0xB6, 0x59, 0x6E, 0x97, 0x4B, 0x2D, 0xCA, 0x5D, 0x74,
+    0xBC, 0x5D, 0x21, 0x54, 0x5A, 0x75, 0x52, 0x8B, 0x52, 0x85, 0x00,
+};
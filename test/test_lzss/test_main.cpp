@@ -0,0 +1,166 @@
+/*
+   This software is licensed under the MIT License. See the license file for details.
+   Source: https://github.com/spacehuhntech/WiFiDuck
+ */
+
+// Files of scripts/compress.py have to decode to the script they were made of,
+// and a truncated one has to end instead of hanging, run with:
+//   pio test -e native -f test_lzss
+
+#include <Arduino.h>
+#include <unity.h>
+
+#include "duckcompiler.h"
+#include "lzss.h"
+#include "reader.h"
+#include "spiffs.h"
+
+#include "scripts.h"
+
+#include <string> // std::string
+
+#define DUCKZ "/test.duckz"
+
+// spiffs::write() appends
+void create(const uint8_t* data, size_t len) {
+    spiffs::remove(DUCKZ);
+    spiffs::write(DUCKZ, data, len);
+}
+
+// Decodes the whole file in parts of n bytes
+std::string decode(size_t n, bool& done) {
+    File f = spiffs::openRead(DUCKZ);
+    lzss::decoder_t* d = lzss::open(f);
+
+    std::string res;
+
+    if (!d) return res;
+
+    uint8_t buf[64];
+    size_t  len;
+
+    while ((len = lzss::decode(d, f, buf, _min(n, sizeof(buf)))) > 0) res.append((const char*)buf, len);
+
+    done = lzss::done(d);
+
+    lzss::close(d);
+
+    return res;
+}
+
+void assertRoundTrip(const uint8_t* duckz, size_t len) {
+    create(duckz, len);
+
+    const size_t parts[] = { 1, 7, 64 };
+
+    for (size_t n : parts) {
+        bool done = false;
+        std::string res = decode(n, done);
+
+        TEST_ASSERT_TRUE(done);
+        TEST_ASSERT_EQUAL(sizeof(script), res.size());
+        TEST_ASSERT_EQUAL_MEMORY(script, res.data(), sizeof(script));
+    }
+}
+
+void setUp() {}
+
+void tearDown() {}
+
+void test_round_trip() {
+    assertRoundTrip(duckz_w8_l4, sizeof(duckz_w8_l4));
+    assertRoundTrip(duckz_w10_l5, sizeof(duckz_w10_l5));
+    assertRoundTrip(duckz_w4_l3, sizeof(duckz_w4_l3));
+}
+
+void test_header() {
+    create(duckz_w8_l4, sizeof(duckz_w8_l4));
+
+    File f = spiffs::openRead(DUCKZ);
+    lzss::header_t h;
+
+    TEST_ASSERT_TRUE(lzss::readHeader(f, h));
+    TEST_ASSERT_EQUAL(8, h.window_bits);
+    TEST_ASSERT_EQUAL(4, h.lookahead_bits);
+    TEST_ASSERT_EQUAL_UINT32(sizeof(script), h.size);
+
+    // A plain script isn't compressed
+    create(script, sizeof(script));
+    f = spiffs::openRead(DUCKZ);
+
+    TEST_ASSERT_NULL(lzss::open(f));
+    TEST_ASSERT_EQUAL(0, f.position());
+}
+
+// Positions of the reader are the ones of the decompressed script
+void test_reader() {
+    create(duckz_w8_l4, sizeof(duckz_w8_l4));
+
+    reader::reader_t r;
+    uint8_t buf[sizeof(script)];
+
+    reader::begin(r, spiffs::openRead(DUCKZ));
+
+    TEST_ASSERT_NOT_NULL(r.decoder);
+    TEST_ASSERT_EQUAL(sizeof(script), reader::available(r));
+    TEST_ASSERT_EQUAL(sizeof(script), reader::read(r, buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_MEMORY(script, buf, sizeof(script));
+    TEST_ASSERT_TRUE(reader::last(r));
+
+    // Going back decompresses from the start again
+    reader::seek(r, 100);
+
+    TEST_ASSERT_EQUAL_UINT32(100, reader::position(r));
+    TEST_ASSERT_EQUAL(10, reader::read(r, buf, 10));
+    TEST_ASSERT_EQUAL_MEMORY(&script[100], buf, 10);
+
+    reader::close(r);
+}
+
+void test_truncated() {
+    for (size_t len = sizeof(lzss::header_t); len < sizeof(duckz_w8_l4); ++len) {
+        create(duckz_w8_l4, len);
+
+        bool done = false;
+        std::string res = decode(64, done);
+
+        char msg[32];
+        snprintf(msg, sizeof(msg), "%u bytes", (unsigned int)len);
+
+        // Ends with what was there
+        TEST_ASSERT_TRUE_MESSAGE(done, msg);
+        TEST_ASSERT_TRUE_MESSAGE(res.size() < sizeof(script), msg);
+        if (res.size() > 0) TEST_ASSERT_EQUAL_MEMORY_MESSAGE(script, res.data(), res.size(), msg);
+    }
+
+    // Not even the header
+    create(duckz_w8_l4, sizeof(lzss::header_t) - 1);
+
+    File f = spiffs::openRead(DUCKZ);
+
+    TEST_ASSERT_NULL(lzss::open(f));
+}
+
+// Code of a truncated script would look complete
+void test_truncated_compile() {
+    create(duckz_w8_l4, sizeof(duckz_w8_l4) - 20);
+
+    TEST_ASSERT_EQUAL_STRING("", duckcompiler::compile(DUCKZ).c_str());
+    TEST_ASSERT_FALSE(spiffs::exists(duckcompiler::codeName(DUCKZ)));
+
+    create(duckz_w8_l4, sizeof(duckz_w8_l4));
+
+    TEST_ASSERT_EQUAL_STRING(duckcompiler::codeName(DUCKZ).c_str(), duckcompiler::compile(DUCKZ).c_str());
+}
+
+int main() {
+    spiffs::begin();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_round_trip);
+    RUN_TEST(test_header);
+    RUN_TEST(test_reader);
+    RUN_TEST(test_truncated);
+    RUN_TEST(test_truncated_compile);
+    return UNITY_END();
+}
@@ -0,0 +1,194 @@
+/*
+   This software is licensed under the MIT License. See the license file for details.
+   Source: https://github.com/spacehuhntech/WiFiDuck
+ */
+
+// Fields of binary requests must never be read behind the end of the request,
+// run with:
+//   pio test -e native -f test_protocol
+
+#include <Arduino.h>
+#include <unity.h>
+
+#include "config.h"
+#include "protocol.h"
+#include "spiffs.h"
+
+#include <string> // std::string
+#include <vector> // std::vector
+
+// Every flush() is one frame of the web socket
+class FramePrint : public Print {
+    public:
+        std::string frame;
+        std::vector<std::string> frames;
+
+        size_t write(uint8_t c) override {
+            frame += (char)c;
+            return 1;
+        }
+
+        void flush() override {
+            frames.push_back(frame);
+            frame.clear();
+        }
+};
+
+FramePrint out;
+
+std::string field(const std::string& data) {
+    uint16_t n = data.size();
+
+    return std::string((const char*)&n, sizeof(n)) + data;
+}
+
+std::string field(uint32_t v) {
+    return field(std::string((const char*)&v, sizeof(v)));
+}
+
+std::string request(uint8_t op, uint16_t id, const std::string& fields) {
+    return std::string(1, (char)op) + std::string((const char*)&id, sizeof(id)) + fields;
+}
+
+void handle(const std::string& req) {
+    out.frames.clear();
+    protocol::handle((const uint8_t*)req.data(), req.size(), out);
+}
+
+uint8_t status() {
+    TEST_ASSERT_EQUAL(1, out.frames.size());
+    TEST_ASSERT_TRUE(out.frames[0].size() >= PROTOCOL_RESPONSE_HEADER_SIZE);
+
+    return (uint8_t)out.frames[0][3];
+}
+
+// The first field of the response
+std::string result() {
+    const std::string& f = out.frames[0];
+    uint16_t n;
+
+    TEST_ASSERT_TRUE(f.size() >= PROTOCOL_RESPONSE_HEADER_SIZE + sizeof(n));
+    memcpy(&n, &f[PROTOCOL_RESPONSE_HEADER_SIZE], sizeof(n));
+    TEST_ASSERT_TRUE(f.size() >= PROTOCOL_RESPONSE_HEADER_SIZE + sizeof(n) + n);
+
+    return f.substr(PROTOCOL_RESPONSE_HEADER_SIZE + sizeof(n), n);
+}
+
+void assertError(const std::string& req, const char* msg) {
+    handle(req);
+
+    TEST_ASSERT_EQUAL(PROTOCOL_ERROR, status());
+    TEST_ASSERT_EQUAL_STRING(msg, result().c_str());
+}
+
+void setUp() {
+    handle(request(PROTOCOL_HELLO, 1, field(std::string(1, PROTOCOL_VERSION))));
+}
+
+void tearDown() {
+    protocol::end();
+}
+
+void test_hello() {
+    TEST_ASSERT_EQUAL(PROTOCOL_OK, status());
+    TEST_ASSERT_EQUAL_HEX8(PROTOCOL_HELLO | PROTOCOL_RESPONSE, (uint8_t)out.frames[0][0]);
+    TEST_ASSERT_EQUAL_STRING(std::string(1, PROTOCOL_VERSION).c_str(), result().c_str());
+}
+
+// Nothing is answered before a client said hello or without a whole header
+void test_no_response() {
+    protocol::end();
+    handle(request(PROTOCOL_STATUS, 2, ""));
+    TEST_ASSERT_EQUAL(0, out.frames.size());
+
+    setUp();
+    handle(std::string(1, PROTOCOL_STATUS));
+    TEST_ASSERT_EQUAL(0, out.frames.size());
+}
+
+void test_id() {
+    handle(request(PROTOCOL_STATUS, 0xBEEF, ""));
+
+    uint16_t id;
+    memcpy(&id, &out.frames[0][1], sizeof(id));
+
+    TEST_ASSERT_EQUAL(PROTOCOL_OK, status());
+    TEST_ASSERT_EQUAL(0xBEEF, id);
+}
+
+void test_field_bounds() {
+    std::string write = request(PROTOCOL_WRITE, 3, field("a.txt") + field(0U) + field("STRING a\n"));
+
+    // Every request that ends early, also in the length of a field
+    for (size_t len = PROTOCOL_REQUEST_HEADER_SIZE; len < write.size(); ++len) {
+        assertError(write.substr(0, len), "missing field");
+    }
+
+    // A length that's larger than the rest
+    std::string longer = request(PROTOCOL_WRITE, 4, field("a.txt") + field(0U));
+    uint16_t    n      = 100;
+
+    longer += std::string((const char*)&n, sizeof(n)) + "STRING a\n";
+    assertError(longer, "missing field");
+
+    // A number that isn't 4 bytes
+    assertError(request(PROTOCOL_READ, 5, field("a.txt") + field("abc") + field(10U)), "missing field");
+
+    // Size of the file
+    handle(write);
+    TEST_ASSERT_EQUAL(PROTOCOL_OK, status());
+    TEST_ASSERT_TRUE(result() == std::string("\x09\0\0\0", 4));
+}
+
+// A field that ends with the request is whole
+void test_last_field() {
+    assertError(request(PROTOCOL_RUN, 6, field("missing.txt")), "missing.txt doesn't exist");
+
+    // Empty, stop takes it as everything
+    handle(request(PROTOCOL_STOP, 7, field("")));
+    TEST_ASSERT_EQUAL(PROTOCOL_OK, status());
+}
+
+void test_unknown() {
+    assertError(request(0x42, 8, ""), "unknown opcode 66");
+}
+
+// Requests that arrive in parts, see webserver.cpp
+void test_parts() {
+    std::string data(300, 'x');
+    std::string req = request(PROTOCOL_WRITE, 9, field("parts.txt") + field(0U) + field(data));
+
+    out.frames.clear();
+
+    for (size_t i = 0; i < req.size(); i += 100) {
+        protocol::receive((const uint8_t*)&req[i], _min((size_t)100, req.size() - i), i, req.size(), out);
+    }
+
+    TEST_ASSERT_EQUAL(PROTOCOL_OK, status());
+    TEST_ASSERT_EQUAL_UINT32(300, spiffs::size("/parts.txt"));
+
+    // Larger than a frame
+    req = request(PROTOCOL_WRITE, 10, field("big.txt") + field(0U) + field(std::string(PROTOCOL_FRAME_SIZE, 'x')));
+    out.frames.clear();
+
+    for (size_t i = 0; i < req.size(); i += 100) {
+        protocol::receive((const uint8_t*)&req[i], _min((size_t)100, req.size() - i), i, req.size(), out);
+    }
+
+    TEST_ASSERT_EQUAL(PROTOCOL_ERROR, status());
+    TEST_ASSERT_FALSE(spiffs::exists("/big.txt"));
+}
+
+int main() {
+    spiffs::begin();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_hello);
+    RUN_TEST(test_no_response);
+    RUN_TEST(test_id);
+    RUN_TEST(test_field_bounds);
+    RUN_TEST(test_last_field);
+    RUN_TEST(test_unknown);
+    RUN_TEST(test_parts);
+    return UNITY_END();
+}
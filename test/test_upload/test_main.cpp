@@ -0,0 +1,155 @@
+/*
+   This software is licensed under the MIT License. See the license file for details.
+   Source: https://github.com/spacehuhntech/WiFiDuck
+ */
+
+// crc32 has to match zlib, clients compute it with it, and chunks of an upload
+// are only written in order and when they're intact, run with:
+//   pio test -e native -f test_upload
+
+#include <Arduino.h>
+#include <unity.h>
+
+#include "config.h"
+#include "spiffs.h"
+#include "upload.h"
+
+#include <string> // std::string
+
+#define CLIENT 1
+
+uint32_t crc32(const char* str) {
+    return upload::crc32((const uint8_t*)str, strlen(str));
+}
+
+// A binary frame of a chunk, see include/upload.h
+std::string chunk(const std::string& data, uint32_t offset, size_t len) {
+    std::string frame(UPLOAD_HEADER_SIZE, '\0');
+    uint32_t    crc = upload::crc32((const uint8_t*)&data[offset], len);
+
+    frame[0] = UPLOAD_MAGIC;
+    memcpy(&frame[1], &offset, sizeof(offset));
+    memcpy(&frame[5], &crc, sizeof(crc));
+    frame.append(data, offset, len);
+
+    return frame;
+}
+
+String send(const std::string& frame, uint32_t client = CLIENT) {
+    return upload::receive((const uint8_t*)frame.data(), frame.size(), 0, frame.size(), client);
+}
+
+std::string contents(String fileName) {
+    File f = spiffs::openRead(fileName);
+    std::string res(f ? f.size() : 0, '\0');
+
+    if (f) f.read((uint8_t*)&res[0], res.size());
+
+    return res;
+}
+
+void setUp() {}
+
+void tearDown() {
+    upload::cancel();
+}
+
+// zlib.crc32() of the same data
+void test_crc32() {
+    TEST_ASSERT_EQUAL_HEX32(0x00000000, crc32(""));
+    TEST_ASSERT_EQUAL_HEX32(0xE8B7BE43, crc32("a"));
+    TEST_ASSERT_EQUAL_HEX32(0x352441C2, crc32("abc"));
+    TEST_ASSERT_EQUAL_HEX32(0xCBF43926, crc32("123456789"));
+    TEST_ASSERT_EQUAL_HEX32(0x414FA339, crc32("The quick brown fox jumps over the lazy dog"));
+
+    uint8_t buf[256];
+
+    for (size_t i = 0; i < sizeof(buf); ++i) buf[i] = i;
+    TEST_ASSERT_EQUAL_HEX32(0x29058C73, upload::crc32(buf, 256));
+
+    memset(buf, 0x00, 32);
+    TEST_ASSERT_EQUAL_HEX32(0x190A55AD, upload::crc32(buf, 32));
+
+    memset(buf, 0xFF, 32);
+    TEST_ASSERT_EQUAL_HEX32(0xFF6CAB0B, upload::crc32(buf, 32));
+}
+
+// The crc of the previous part continues it
+void test_crc32_parts() {
+    const uint8_t* str = (const uint8_t*)"The quick brown fox jumps over the lazy dog";
+
+    uint32_t crc = upload::crc32(str, 10);
+
+    crc = upload::crc32(&str[10], 33, crc);
+
+    TEST_ASSERT_EQUAL_HEX32(0x414FA339, crc);
+}
+
+void test_upload() {
+    std::string data;
+
+    for (size_t i = 0; i < 3000; ++i) data += (char)('a' + (i * 7) % 26);
+
+    uint32_t crc = upload::crc32((const uint8_t*)data.data(), data.size());
+
+    TEST_ASSERT_EQUAL_STRING(("> upload 0 " + String(UPLOAD_WINDOW)).c_str(), upload::start("up.txt", data.size(), crc, CLIENT).c_str());
+
+    TEST_ASSERT_EQUAL_STRING("> ack 1024", send(chunk(data, 0, 1024)).c_str());
+
+    // Wrong offset
+    TEST_ASSERT_EQUAL_STRING("> ack 1024", send(chunk(data, 2048, 952)).c_str());
+
+    // Broken data
+    std::string broken = chunk(data, 1024, 1024);
+    broken.back() ^= 1;
+    TEST_ASSERT_EQUAL_STRING("> ack 1024", send(broken).c_str());
+
+    // Another client
+    TEST_ASSERT_EQUAL_STRING("ERROR: no upload", send(chunk(data, 1024, 1024), CLIENT + 1).c_str());
+
+    // A chunk in two parts
+    std::string frame = chunk(data, 1024, 1024);
+
+    TEST_ASSERT_EQUAL_STRING("", upload::receive((const uint8_t*)frame.data(), 100, 0, frame.size(), CLIENT).c_str());
+    TEST_ASSERT_EQUAL_STRING("> ack 2048", upload::receive((const uint8_t*)&frame[100], frame.size() - 100, 100, frame.size(), CLIENT).c_str());
+
+    TEST_ASSERT_EQUAL_STRING("> uploaded /up.txt", send(chunk(data, 2048, 952)).c_str());
+    TEST_ASSERT_FALSE(upload::uploading());
+    TEST_ASSERT_FALSE(spiffs::exists("/up.txt" UPLOAD_EXTENSION));
+    TEST_ASSERT_TRUE(contents("/up.txt") == data);
+}
+
+// A dropped connection continues where it stopped
+void test_resume() {
+    std::string data(2000, 'x');
+    uint32_t    crc = upload::crc32((const uint8_t*)data.data(), data.size());
+
+    upload::start("resume.txt", data.size(), crc, CLIENT);
+    send(chunk(data, 0, 1024));
+    upload::pause();
+
+    TEST_ASSERT_EQUAL_STRING("ERROR: no upload", send(chunk(data, 1024, 976)).c_str());
+    TEST_ASSERT_EQUAL_STRING(("> upload 1024 " + String(UPLOAD_WINDOW)).c_str(), upload::start("resume.txt", data.size(), crc, CLIENT + 1).c_str());
+    TEST_ASSERT_EQUAL_STRING("> uploaded /resume.txt", send(chunk(data, 1024, 976), CLIENT + 1).c_str());
+    TEST_ASSERT_TRUE(contents("/resume.txt") == data);
+}
+
+void test_wrong_crc() {
+    upload::start("wrong.txt", 5, 0, CLIENT);
+
+    TEST_ASSERT_EQUAL_STRING("> upload failed, crc32 of /wrong.txt doesn't match", send(chunk("hello", 0, 5)).c_str());
+    TEST_ASSERT_FALSE(spiffs::exists("/wrong.txt"));
+    TEST_ASSERT_FALSE(spiffs::exists("/wrong.txt" UPLOAD_EXTENSION));
+}
+
+int main() {
+    spiffs::begin();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_crc32);
+    RUN_TEST(test_crc32_parts);
+    RUN_TEST(test_upload);
+    RUN_TEST(test_resume);
+    RUN_TEST(test_wrong_crc);
+    return UNITY_END();
+}